@@ -328,19 +328,34 @@ INSERT INTO `command` VALUES
 ('cooldown',3,'Syntax: .cooldown [#spell_id]\r\n\r\nRemove all (if spell_id not provided) or #spel_id spell cooldown from selected character or you (if no selection).'),
 ('damage',3,'Syntax: .damage $damage_amount [$school [$spellid]]\r\n\r\nApply $damage to target. If not $school and $spellid provided then this flat clean melee damage without any modifiers. If $school provided then damage modified by armor reduction (if school physical), and target absorbing modifiers and result applied as melee damage to target. If spell provided then damage modified and applied as spell damage. $spellid can be shift-link.'),
 ('debug anim',2,'Syntax: .debug anim #emoteid\r\n\r\nPlay emote #emoteid for your character.'),
+('debug aoebench',3,'Syntax: .debug aoebench #spellid [#radius] [#iterations]\r\n\r\nSelect the targets of an area spell #spellid at your position, radius #radius (default 30) and up to 40 targets, #iterations times (default 100). Once with the grid notifiers and once with the spell area query. Show the casts per second of both.'),
 ('debug arena',3,'Syntax: .debug arena\r\n\r\nToggle debug mode for arenas. In debug mode GM can start arena with single player.'),
 ('debug bg',3,'Syntax: .debug bg\r\n\r\nToggle debug mode for battlegrounds. In debug mode GM can start battleground with single player.'),
+('debug broadcastbench',3,'Syntax: .debug broadcastbench [#receivers] [#size] [#iterations]\r\n\r\nBroadcast a #size byte packet (default 1000, at most 65535) to #receivers sockets (default 50, at most 1000) #iterations times (default 10000) without sending it. Once with the body copied into the output buffer of every receiver and once shared by all receivers. Show the time of both and the broadcasts per second.'),
+('debug compression',3,'Syntax: .debug compression\r\n\r\nShow the update packet compression level and threshold, and the bytes saved by compression since server start.'),
+('debug db async',3,'Syntax: .debug db async\r\n\r\nShow the async workers, operations, queue depth and latency histograms of the world, character and login databases.'),
+('debug db loadbench',4,'Syntax: .debug db loadbench [$table]\r\n\r\nRead all fields of all rows of world database table $table (default creature), once as text result and once as binary protocol result. Show the rows read per second of both.'),
+('debug db stats',3,'Syntax: .debug db stats [#count]\r\n        .debug db stats reset\r\n\r\nShow the #count (default 5) async statements with the highest total time of the world, character and login databases, or reset the collected profiles.'),
+('debug db stmtbench',4,'Syntax: .debug db stmtbench [#count]\r\n\r\nRun #count (default 10000, at most 100000) single row updates that change nothing on the character database, once as formatted SQL and once as prepared statement. Show the statements per second of both.'),
+('debug flushbench',3,'Syntax: .debug flushbench [#iterations]\r\n\r\nFlush the units in visibility range as changed objects to the players of the map that see them, #iterations times (default 100) with the std::set queue and per call player map used before and with the update queue and batch of the map. Packets are not built or sent. Show the time of both and the objects flushed per millisecond.'),
 ('debug getitemvalue',3,'Syntax: .debug getitemvalue #itemguid #field [int|hex|bit|float]\r\n\r\nGet the field #field of the item #itemguid in your inventroy.\r\n\r\nUse type arg for set output format: int (decimal number), hex (hex value), bit (bitstring), float. By default use integer output.'),
 ('debug getvalue',3,'Syntax: .debug getvalue #field [int|hex|bit|float]\r\n\r\nGet the field #field of the selected target. If no target is selected, get the content of your field.\r\n\r\nUse type arg for set output format: int (decimal number), hex (hex value), bit (bitstring), float. By default use integer output.'),
+('debug mapupdate',3,'Syntax: .debug mapupdate [#count]\r\n\r\nShow the map update thread count and the last, average and max update time of the #count slowest maps (default 10).'),
 ('debug moditemvalue',3,'Syntax: .debug moditemvalue #guid #field [int|float| &= | |= | &=~ ] #value\r\n\r\nModify the field #field of the item #itemguid in your inventroy by value #value. \r\n\r\nUse type arg for set mode of modification: int (normal add/subtract #value as decimal number), float (add/subtract #value as float number), &= (bit and, set to 0 all bits in value if it not set to 1 in #value as hex number), |= (bit or, set to 1 all bits in value if it set to 1 in #value as hex number), &=~ (bit and not, set to 0 all bits in value if it set to 1 in #value as hex number). By default expect integer add/subtract.'),
 ('debug modvalue',3,'Syntax: .debug modvalue #field [int|float| &= | |= | &=~ ] #value\r\n\r\nModify the field #field of the selected target by value #value. If no target is selected, set the content of your field.\r\n\r\nUse type arg for set mode of modification: int (normal add/subtract #value as decimal number), float (add/subtract #value as float number), &= (bit and, set to 0 all bits in value if it not set to 1 in #value as hex number), |= (bit or, set to 1 all bits in value if it set to 1 in #value as hex number), &=~ (bit and not, set to 0 all bits in value if it set to 1 in #value as hex number). By default expect integer add/subtract.'),
+('debug netsend',3,'Syntax: .debug netsend\r\n\r\nShow the bytes sent to clients, the send calls and the bytes copied into output buffers or queued as shared packets since server start.'),
 ('debug play cinematic',1,'Syntax: .debug play cinematic #cinematicid\r\n\r\nPlay cinematic #cinematicid for you. You stay at place while your mind fly.\r\n'),
 ('debug play movie',1,'Syntax: .debug play movie #movieid\r\n\r\nPlay movie #movieid for you.'),
 ('debug play sound',1,'Syntax: .debug play sound #soundid\r\n\r\nPlay sound with #soundid.\r\nSound will be play only for you. Other players do not hear this.\r\nWarning: client may have more 5000 sounds...'),
+('debug procbench',3,'Syntax: .debug procbench [#iterations]\r\n\r\nSelect the proc candidates of a melee hit of the selected unit #iterations times (default 100000), once by a scan of all its auras and once by its proc index. Show the procs per second of both.'),
+('debug rangequery',3,'Syntax: .debug rangequery [#radius] [#iterations]\r\n\r\nSearch the units within #radius (default 30) around you #iterations times (default 100), once with the grid notifiers and once with the map position index. Show the units found and the time of both.'),
+('debug recvqueue',3,'Syntax: .debug recvqueue [$playername]\r\n\r\nShow the receive packet queue fill, capacity, peak and dropped packets of the selected or named player session.'),
 ('debug setitemvalue',3,'Syntax: .debug setitemvalue #guid #field [int|hex|bit|float] #value\r\n\r\nSet the field #field of the item #itemguid in your inventroy to value #value.\r\n\r\nUse type arg for set input format: int (decimal number), hex (hex value), bit (bitstring), float. By default expect integer input format.'),
 ('debug setvalue',3,'Syntax: .debug setvalue #field [int|hex|bit|float] #value\r\n\r\nSet the field #field of the selected target to value #value. If no target is selected, set the content of your field.\r\n\r\nUse type arg for set input format: int (decimal number), hex (hex value), bit (bitstring), float. By default expect integer input format.'),
 ('debug spellcoefs',3,'Syntax: .debug spellcoefs #spellid\r\n\r\nShow default calculated and DB stored coefficients for direct/dot heal/damage.'),
+('debug spellinfo',4,'Syntax: .debug spellinfo [#iterations]\r\n\r\nRead the per cast data of all spells #iterations times (default 10), once through the DBC store lookups and once through SpellInfo. Show the spells per second of both.'),
 ('debug spellmods',3,'Syntax: .debug spellmods (flat|pct) #spellMaskBitIndex #spellModOp #value\r\n\r\nSet at client side spellmod affect for spell that have bit set with index #spellMaskBitIndex in spell family mask for values dependent from spellmod #spellModOp to #value.'),
+('debug valuesbench',3,'Syntax: .debug valuesbench [#viewers] [#iterations]\r\n\r\nBuild the values update blocks of the selected unit with all its set fields changed for #viewers players (default 40) that have it at client, #iterations times (default 1000). Once built for every viewer and once shared per viewer class. Show the time of both and the cost per viewer.'),
 ('delticket',2,'Syntax: .delticket all\r\n        .delticket #num\r\n        .delticket $character_name\r\n\rall to dalete all tickets at server, $character_name to delete ticket of this character, #num to delete ticket #num.'),
 ('demorph',2,'Syntax: .demorph\r\n\r\nDemorph the selected player.'),
 ('die',3,'Syntax: .die\r\n\r\nKill the selected player. If no player is selected, it will kill you.'),
@@ -416,6 +416,9 @@ namespace MaNGOS
             virtual ~IQueryCallback() {}
             virtual void SetResult(QueryResult* result) = 0;
             virtual QueryResult* GetResult() = 0;
+            // called before deleting a callback that will never be executed, frees what its
+            // handler would have owned apart from the result
+            virtual void Drop() {}
     };
 
     template<class CB>
@@ -0,0 +1,199 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _FLATLIST
+#define _FLATLIST
+
+#include "Common.h"
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+/**
+ * Vector backed replacement for std::list of pointers.
+ *
+ * Elements are kept contiguous, so walking the list doesn't chase nodes and
+ * push_back doesn't allocate once the list reached its usual size. Iterators
+ * are positions, not pointers into the storage, and removed elements only
+ * leave a NULL hole behind: like with std::list, an iterator stays valid when
+ * other elements are added or removed while iterating. Holes are skipped by
+ * the iterators and squeezed out by Compact(), which the owner must only call
+ * when nothing iterates the list (e.g. once per update).
+ *
+ * T must be a pointer type, NULL elements are not allowed.
+ */
+template<class T>
+class FlatList
+{
+    private:
+        typedef std::vector<T> Storage;
+
+        static size_t const npos = size_t(-1);              // end() position, stays end() when elements are added
+
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+
+        class const_iterator
+        {
+            public:
+                typedef std::bidirectional_iterator_tag iterator_category;
+                typedef T value_type;
+                typedef ptrdiff_t difference_type;
+                typedef T const* pointer;
+                typedef T const& reference;
+
+                const_iterator() : m_list(NULL), m_pos(npos) {}
+
+                T const& operator*() const { return m_list->m_items[m_pos]; }
+                T const* operator->() const { return &m_list->m_items[m_pos]; }
+
+                const_iterator& operator++() { m_pos = m_list->NextPos(m_pos + 1); return *this; }
+                const_iterator operator++(int) { const_iterator tmp = *this; ++*this; return tmp; }
+                const_iterator& operator--() { m_pos = m_list->PrevPos(m_pos); return *this; }
+                const_iterator operator--(int) { const_iterator tmp = *this; --*this; return tmp; }
+
+                bool operator==(const_iterator const& other) const { return m_pos == other.m_pos; }
+                bool operator!=(const_iterator const& other) const { return m_pos != other.m_pos; }
+
+            protected:
+                friend class FlatList<T>;
+
+                const_iterator(FlatList const* list, size_t pos) : m_list(list), m_pos(pos) {}
+
+                FlatList const* m_list;
+                size_t m_pos;
+        };
+
+        class iterator : public const_iterator
+        {
+            public:
+                typedef T* pointer;
+                typedef T& reference;
+
+                iterator() {}
+
+                T& operator*() const { return const_cast<FlatList*>(this->m_list)->m_items[this->m_pos]; }
+                T* operator->() const { return &**this; }
+
+                iterator& operator++() { const_iterator::operator++(); return *this; }
+                iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+                iterator& operator--() { const_iterator::operator--(); return *this; }
+                iterator operator--(int) { iterator tmp = *this; --*this; return tmp; }
+
+            private:
+                friend class FlatList<T>;
+
+                iterator(FlatList* list, size_t pos) : const_iterator(list, pos) {}
+        };
+
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        FlatList() : m_size(0) {}
+
+        iterator begin() { return iterator(this, NextPos(0)); }
+        iterator end() { return iterator(this, npos); }
+        const_iterator begin() const { return const_iterator(this, NextPos(0)); }
+        const_iterator end() const { return const_iterator(this, npos); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        T& front() { return *begin(); }
+        T const& front() const { return *begin(); }
+        T& back() { return *--end(); }
+        T const& back() const { return *--end(); }
+
+        void push_back(T const& value)
+        {
+            m_items.push_back(value);
+            ++m_size;
+        }
+
+        // remove all elements equal to value
+        void remove(T const& value)
+        {
+            for (typename Storage::iterator itr = m_items.begin(); itr != m_items.end(); ++itr)
+            {
+                if (*itr == value)
+                {
+                    *itr = NULL;
+                    --m_size;
+                }
+            }
+        }
+
+        // returns the iterator following the erased element
+        iterator erase(iterator itr)
+        {
+            m_items[itr.m_pos] = NULL;
+            --m_size;
+            return ++itr;
+        }
+
+        void clear()
+        {
+            m_items.clear();
+            m_size = 0;
+        }
+
+        // drop the holes left by removed elements, invalidates all iterators
+        void Compact()
+        {
+            if (m_items.size() != m_size)
+                m_items.erase(std::remove(m_items.begin(), m_items.end(), T(NULL)), m_items.end());
+        }
+
+        bool HasHoles() const { return m_items.size() != m_size; }
+
+    private:
+        friend class const_iterator;
+        friend class iterator;
+
+        // first element at or after pos, npos if none
+        size_t NextPos(size_t pos) const
+        {
+            for (; pos < m_items.size(); ++pos)
+                if (m_items[pos])
+                    return pos;
+            return npos;
+        }
+
+        // last element before pos (npos is after all elements)
+        size_t PrevPos(size_t pos) const
+        {
+            if (pos == npos)
+                pos = m_items.size();
+
+            while (pos > 0)
+                if (m_items[--pos])
+                    return pos;
+            return npos;
+        }
+
+        Storage m_items;
+        size_t m_size;                                      // elements without holes
+};
+
+#endif
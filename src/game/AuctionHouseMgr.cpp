@@ -148,7 +148,10 @@ void AuctionHouseMgr::SendAuctionWonMail(AuctionEntry* auction)
 
         // set owner to bidder (to prevent delete item with sender char deleting)
         // owner in `data` will set at mail receive and item extracting
-        CharacterDatabase.PExecute("UPDATE item_instance SET owner_guid = '%u' WHERE guid='%u'", auction->bidder, auction->itemGuidLow);
+        static SqlStatementID updItemOwner ;
+
+        SqlStatement stmt = CharacterDatabase.CreateStatement(updItemOwner, "UPDATE item_instance SET owner_guid = ? WHERE guid = ?");
+        stmt.PExecute(auction->bidder, auction->itemGuidLow);
 
         if (bidder)
         {
@@ -168,7 +171,11 @@ void AuctionHouseMgr::SendAuctionWonMail(AuctionEntry* auction)
     // receiver not exist
     else
     {
-        CharacterDatabase.PExecute("DELETE FROM item_instance WHERE guid='%u'", auction->itemGuidLow);
+        static SqlStatementID delItem ;
+
+        SqlStatement stmt = CharacterDatabase.CreateStatement(delItem, "DELETE FROM item_instance WHERE guid = ?");
+        stmt.PExecute(auction->itemGuidLow);
+
         RemoveAItem(auction->itemGuidLow);                  // we have to remove the item, before we delete it !!
         auction->itemGuidLow = 0;
         delete pItem;
@@ -254,7 +261,11 @@ void AuctionHouseMgr::SendAuctionExpiredMail(AuctionEntry* auction)
     // owner not found
     else
     {
-        CharacterDatabase.PExecute("DELETE FROM item_instance WHERE guid='%u'", auction->itemGuidLow);
+        static SqlStatementID delItem ;
+
+        SqlStatement stmt = CharacterDatabase.CreateStatement(delItem, "DELETE FROM item_instance WHERE guid = ?");
+        stmt.PExecute(auction->itemGuidLow);
+
         RemoveAItem(auction->itemGuidLow);                  // we have to remove the item, before we delete it !!
         auction->itemGuidLow = 0;
         delete pItem;
@@ -983,24 +994,44 @@ uint64 AuctionEntry::GetAuctionOutBid() const
 
 void AuctionEntry::DeleteFromDB() const
 {
-    // No SQL injection (Id is integer)
-    CharacterDatabase.PExecute("DELETE FROM auction WHERE id = '%u'", Id);
+    static SqlStatementID delAuction ;
+
+    SqlStatement stmt = CharacterDatabase.CreateStatement(delAuction, "DELETE FROM auction WHERE id = ?");
+    stmt.PExecute(Id);
 }
 
 void AuctionEntry::SaveToDB() const
 {
-    // No SQL injection (no strings)
-    CharacterDatabase.PExecute("INSERT INTO auction (id,houseid,itemguid,item_template,item_count,item_randompropertyid,itemowner,buyoutprice,time,moneyTime,buyguid,lastbid,startbid,deposit) "
-                               "VALUES ('%u', '%u', '%u', '%u', '%u', '%i', '%u', '" UI64FMTD "', '" UI64FMTD "', '" UI64FMTD "', '%u', '" UI64FMTD "', '" UI64FMTD "', '" UI64FMTD "')",
-                               Id, auctionHouseEntry->houseId, itemGuidLow, itemTemplate, itemCount, itemRandomPropertyId, owner, buyout, (uint64)expireTime, (uint64)moneyDeliveryTime, bidder, bid, startbid, deposit);
+    static SqlStatementID insAuction ;
+
+    SqlStatement stmt = CharacterDatabase.CreateStatement(insAuction, "INSERT INTO auction (id,houseid,itemguid,item_template,item_count,item_randompropertyid,itemowner,buyoutprice,time,moneyTime,buyguid,lastbid,startbid,deposit) "
+                        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    stmt.addUInt32(Id);
+    stmt.addUInt32(auctionHouseEntry->houseId);
+    stmt.addUInt32(itemGuidLow);
+    stmt.addUInt32(itemTemplate);
+    stmt.addUInt32(itemCount);
+    stmt.addInt32(itemRandomPropertyId);
+    stmt.addUInt32(owner);
+    stmt.addUInt64(buyout);
+    stmt.addUInt64(uint64(expireTime));
+    stmt.addUInt64(uint64(moneyDeliveryTime));
+    stmt.addUInt32(bidder);
+    stmt.addUInt64(bid);
+    stmt.addUInt64(startbid);
+    stmt.addUInt64(deposit);
+    stmt.Execute();
 }
 
 void AuctionEntry::AuctionBidWinning(Player* newbidder)
 {
     moneyDeliveryTime = time(NULL) + HOUR;
 
+    static SqlStatementID updAuction ;
+
     CharacterDatabase.BeginTransaction();
-    CharacterDatabase.PExecute("UPDATE auction SET itemguid = 0, moneyTime = '" UI64FMTD "', buyguid = '%u', lastbid = '" UI64FMTD "' WHERE id = '%u'", (uint64)moneyDeliveryTime, bidder, bid, Id);
+    SqlStatement stmt = CharacterDatabase.CreateStatement(updAuction, "UPDATE auction SET itemguid = 0, moneyTime = ?, buyguid = ?, lastbid = ? WHERE id = ?");
+    stmt.PExecute(uint64(moneyDeliveryTime), bidder, bid, Id);
     if (newbidder)
         newbidder->SaveInventoryAndGoldToDB();
     CharacterDatabase.CommitTransaction();
@@ -1037,9 +1068,12 @@ bool AuctionEntry::UpdateBid(uint64 newbid, Player* newbidder /*=NULL*/)
         if (auction_owner)
             auction_owner->GetSession()->SendAuctionOwnerNotification(this);
 
+        static SqlStatementID updAuctionBid ;
+
         // after this update we should save player's money ...
         CharacterDatabase.BeginTransaction();
-        CharacterDatabase.PExecute("UPDATE auction SET buyguid = '%u', lastbid = '" UI64FMTD "' WHERE id = '%u'", bidder, bid, Id);
+        SqlStatement stmt = CharacterDatabase.CreateStatement(updAuctionBid, "UPDATE auction SET buyguid = ?, lastbid = ? WHERE id = ?");
+        stmt.PExecute(bidder, bid, Id);
         if (newbidder)
             newbidder->SaveInventoryAndGoldToDB();
         CharacterDatabase.CommitTransaction();
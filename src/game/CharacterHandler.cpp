@@ -116,16 +116,6 @@ bool LoginQueryHolder::Initialize()
 class CharacterHandler
 {
     public:
-        void HandleCharEnumCallback(QueryResult* result, uint32 account)
-        {
-            WorldSession* session = sWorld.FindSession(account);
-            if (!session)
-            {
-                delete result;
-                return;
-            }
-            session->HandleCharEnum(result);
-        }
         void HandlePlayerLoginCallback(QueryResult* /*dummy*/, SqlQueryHolder* holder)
         {
             if (!holder) return;
@@ -160,12 +150,14 @@ void WorldSession::HandleCharEnum(QueryResult * result)
             if (!Player::BuildEnumData(result, &data, &buffer))
             {
                 sLog.outError("Building enum data for SMSG_CHAR_ENUM has failed, aborting");
+                delete result;
                 return;
             }
         }
         while (result->NextRow());
 
         data.append(buffer);
+        delete result;
     }
 
     SendPacket(&data);
@@ -174,7 +166,8 @@ void WorldSession::HandleCharEnum(QueryResult * result)
 void WorldSession::HandleEnumChar(WorldPacket& /*recv_data*/)
 {
     /// get all the data necessary for loading all characters (along with their pets) on the account
-    CharacterDatabase.AsyncPQuery(&chrHandler, &CharacterHandler::HandleCharEnumCallback, GetAccountId(),
+    // executed by the Update() of this session, so the callback can't outlive it
+    CharacterDatabase.AsyncPQuery(GetQueryResultQueue(), this, &WorldSession::HandleCharEnum,
                                   !sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED) ?
                                   //   ------- Query Without Declined Names --------
                                   //           0               1                2                3                 4                  5                       6                        7
@@ -580,6 +573,8 @@ void WorldSession::HandlePlayerLoginOpcode(WorldPacket & recv_data )
         return;
     }
 
+    // load on the worker that also executes the saves of this character
+    holder->SetShardKey(playerGuid.GetCounter());
     CharacterDatabase.DelayQueryHolder(&chrHandler, &CharacterHandler::HandlePlayerLoginCallback, holder);
 }
 
@@ -971,29 +966,37 @@ void WorldSession::HandleCharRenameOpcode(WorldPacket& recv_data)
     std::string escaped_newname = newname;
     CharacterDatabase.escape_string(escaped_newname);
 
-    // make sure that the character belongs to the current account, that rename at login is enabled
-    // and that there is no character with the desired new name
-    CharacterDatabase.AsyncPQuery(&WorldSession::HandleChangePlayerNameOpcodeCallBack,
-                                  GetAccountId(), newname,
-                                  "SELECT guid, name FROM characters WHERE guid = %u AND account = %u AND (at_login & %u) = %u AND NOT EXISTS (SELECT NULL FROM characters WHERE name = '%s')",
-                                  guid.GetCounter(), GetAccountId(), AT_LOGIN_RENAME, AT_LOGIN_RENAME, escaped_newname.c_str()
-                                 );
+    // make sure that there is no character with the desired new name, then that the character
+    // belongs to the current account and that rename at login is enabled
+    SqlQueryChain<WorldSession> chain(CharacterDatabase, GetQueryResultQueue(), this);
+    chain.PQuery(&WorldSession::HandleChangePlayerNameOpcodeCallBack, guid.GetCounter(), newname,
+                 "SELECT guid FROM characters WHERE name = '%s'", escaped_newname.c_str());
 }
 
-void WorldSession::HandleChangePlayerNameOpcodeCallBack(QueryResult* result, uint32 accountId, std::string newname)
+void WorldSession::HandleChangePlayerNameOpcodeCallBack(QueryResult* result, SqlQueryChain<WorldSession> chain, uint32 guidLow, std::string newname)
 {
-    WorldSession* session = sWorld.FindSession(accountId);
-    if (!session)
+    if (result)
     {
-        if (result) delete result;
+        delete result;
+
+        WorldPacket data(SMSG_CHARACTER_RENAME_RESULT, 1);
+        data << uint8(CHAR_CREATE_NAME_IN_USE);
+        SendPacket(&data);
         return;
     }
 
+    chain.PQuery(&WorldSession::HandleChangePlayerNameOwnerCallBack, newname,
+                 "SELECT guid, name FROM characters WHERE guid = %u AND account = %u AND (at_login & %u) = %u",
+                 guidLow, GetAccountId(), uint32(AT_LOGIN_RENAME), uint32(AT_LOGIN_RENAME));
+}
+
+void WorldSession::HandleChangePlayerNameOwnerCallBack(QueryResult* result, SqlQueryChain<WorldSession> /*chain*/, std::string newname)
+{
     if (!result)
     {
         WorldPacket data(SMSG_CHARACTER_RENAME_RESULT, 1);
         data << uint8(CHAR_CREATE_ERROR);
-        session->SendPacket(&data);
+        SendPacket(&data);
         return;
     }
 
@@ -1008,13 +1011,13 @@ void WorldSession::HandleChangePlayerNameOpcodeCallBack(QueryResult* result, uin
     CharacterDatabase.PExecute("DELETE FROM character_declinedname WHERE guid ='%u'", guidLow);
     CharacterDatabase.CommitTransaction();
 
-    sLog.outChar("Account: %d (IP: %s) Character:[%s] (guid:%u) Changed name to: %s", session->GetAccountId(), session->GetRemoteAddress().c_str(), oldname.c_str(), guidLow, newname.c_str());
+    sLog.outChar("Account: %d (IP: %s) Character:[%s] (guid:%u) Changed name to: %s", GetAccountId(), GetRemoteAddress().c_str(), oldname.c_str(), guidLow, newname.c_str());
 
     WorldPacket data(SMSG_CHARACTER_RENAME_RESULT, 1 + 8 + (newname.size() + 1));
     data << uint8(RESPONSE_SUCCESS);
     data << guid;
     data << newname;
-    session->SendPacket(&data);
+    SendPacket(&data);
 
     sWorld.InvalidatePlayerDataToAllClient(guid);
 }
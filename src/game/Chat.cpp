@@ -211,6 +211,15 @@ ChatCommand* ChatHandler::getCommandTable()
         { NULL,             0,                  false, NULL,                                           "", NULL }
     };
 
+    static ChatCommand debugDbCommandTable[] =
+    {
+        { "async",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugDbAsyncCommand,             "", NULL },
+        { "loadbench",      SEC_CONSOLE,        true,  &ChatHandler::HandleDebugDbLoadBenchCommand,         "", NULL },
+        { "stmtbench",      SEC_CONSOLE,        true,  &ChatHandler::HandleDebugDbStmtBenchCommand,         "", NULL },
+        { "stats",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugDbStatsCommand,             "", NULL },
+        { NULL,             0,                  false, NULL,                                                "", NULL }
+    };
+
     static ChatCommand debugPlayCommandTable[] =
     {
         { "cinematic",      SEC_MODERATOR,      false, &ChatHandler::HandleDebugPlayCinematicCommand,       "", NULL },
@@ -239,23 +248,35 @@ ChatCommand* ChatHandler::getCommandTable()
     static ChatCommand debugCommandTable[] =
     {
         { "anim",           SEC_GAMEMASTER,     false, &ChatHandler::HandleDebugAnimCommand,                "", NULL },
+        { "aoebench",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugAoEBenchCommand,            "", NULL },
         { "arena",          SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugArenaCommand,               "", NULL },
         { "bg",             SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugBattlegroundCommand,        "", NULL },
+        { "broadcastbench", SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugBroadcastBenchCommand,      "", NULL },
+        { "compression",    SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugCompressionCommand,         "", NULL },
+        { "db",             SEC_ADMINISTRATOR,  true,  NULL,                                                "", debugDbCommandTable },
+        { "flushbench",     SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugFlushBenchCommand,          "", NULL },
         { "getitemstate",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugGetItemStateCommand,        "", NULL },
         { "lootrecipient",  SEC_GAMEMASTER,     false, &ChatHandler::HandleDebugGetLootRecipientCommand,    "", NULL },
+        { "mapupdate",      SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugMapUpdateCommand,           "", NULL },
         { "getitemvalue",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugGetItemValueCommand,        "", NULL },
         { "getvalue",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugGetValueCommand,            "", NULL },
         { "moditemvalue",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugModItemValueCommand,        "", NULL },
+        { "netsend",        SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugNetSendCommand,             "", NULL },
         { "modvalue",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugModValueCommand,            "", NULL },
         { "play",           SEC_MODERATOR,      false, NULL,                                                "", debugPlayCommandTable },
+        { "procbench",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugProcBenchCommand,           "", NULL },
+        { "rangequery",     SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugRangeQueryCommand,          "", NULL },
+        { "recvqueue",      SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugRecvQueueCommand,           "", NULL },
         { "send",           SEC_ADMINISTRATOR,  false, NULL,                                                "", debugSendCommandTable },
         { "setaurastate",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugSetAuraStateCommand,        "", NULL },
         { "setitemvalue",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugSetItemValueCommand,        "", NULL },
         { "setvalue",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugSetValueCommand,            "", NULL },
         { "spellcheck",     SEC_CONSOLE,        true,  &ChatHandler::HandleDebugSpellCheckCommand,          "", NULL },
         { "spellcoefs",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugSpellCoefsCommand,          "", NULL },
+        { "spellinfo",      SEC_CONSOLE,        true,  &ChatHandler::HandleDebugSpellInfoCommand,           "", NULL },
         { "spellmods",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugSpellModsCommand,           "", NULL },
         { "uws",            SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugUpdateWorldStateCommand,    "", NULL },
+        { "valuesbench",    SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugValuesBenchCommand,         "", NULL },
         { NULL,             0,                  false, NULL,                                                "", NULL }
     };
 
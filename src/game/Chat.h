@@ -33,6 +33,7 @@ struct FactionState;
 struct GameTele;
 struct SpellEntry;
 
+class Database;
 class QueryResult;
 class ChatHandler;
 class WorldSession;
@@ -218,21 +219,36 @@ class MANGOS_DLL_SPEC ChatHandler
         bool HandleCharacterTitlesCommand(char* args);
 
         bool HandleDebugAnimCommand(char* args);
+        bool HandleDebugAoEBenchCommand(char* args);
         bool HandleDebugArenaCommand(char* args);
         bool HandleDebugBattlegroundCommand(char* args);
+        bool HandleDebugBroadcastBenchCommand(char* args);
+        bool HandleDebugCompressionCommand(char* args);
+        bool HandleDebugDbAsyncCommand(char* args);
+        bool HandleDebugDbLoadBenchCommand(char* args);
+        bool HandleDebugDbStmtBenchCommand(char* args);
+        bool HandleDebugDbStatsCommand(char* args);
+        bool HandleDebugFlushBenchCommand(char* args);
         bool HandleDebugGetItemStateCommand(char* args);
         bool HandleDebugGetItemValueCommand(char* args);
         bool HandleDebugGetLootRecipientCommand(char* args);
         bool HandleDebugGetValueCommand(char* args);
+        bool HandleDebugMapUpdateCommand(char* args);
         bool HandleDebugModItemValueCommand(char* args);
         bool HandleDebugModValueCommand(char* args);
+        bool HandleDebugNetSendCommand(char* args);
+        bool HandleDebugProcBenchCommand(char* args);
+        bool HandleDebugRangeQueryCommand(char* args);
+        bool HandleDebugRecvQueueCommand(char* args);
         bool HandleDebugSetAuraStateCommand(char* args);
         bool HandleDebugSetItemValueCommand(char* args);
         bool HandleDebugSetValueCommand(char* args);
         bool HandleDebugSpellCheckCommand(char* args);
         bool HandleDebugSpellCoefsCommand(char* args);
+        bool HandleDebugSpellInfoCommand(char* args);
         bool HandleDebugSpellModsCommand(char* args);
         bool HandleDebugUpdateWorldStateCommand(char* args);
+        bool HandleDebugValuesBenchCommand(char* args);
 
         bool HandleDebugPlayCinematicCommand(char* args);
         bool HandleDebugPlayMovieCommand(char* args);
@@ -693,6 +709,8 @@ class MANGOS_DLL_SPEC ChatHandler
         void ShowCurrencyListHelper(Player* target, CurrencyTypesEntry const* currency, LocaleConstant loc);
         void ShowSpellListHelper(Player* target, SpellEntry const* spellInfo, LocaleConstant loc);
         void ShowPoolListHelper(uint16 pool_id);
+        void ShowAsyncDatabaseStatsHelper(char const* name, Database& db);
+        void ShowDatabaseProfileHelper(char const* name, Database& db, uint32 limit);
         void ShowTicket(GMTicket const* ticket);
         void ShowTriggerListHelper(AreaTriggerEntry const* atEntry);
         void ShowTriggerTargetListHelper(uint32 id, AreaTrigger const* at, bool subpart = false);
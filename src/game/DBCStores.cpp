@@ -23,6 +23,7 @@
 #include "SharedDefines.h"
 #include "SpellAuraDefines.h"
 #include "ObjectGuid.h"
+#include "SpellMgr.h"
 
 #include "DBCfmt.h"
 
@@ -192,7 +193,8 @@ DBCStorage <SpellShapeshiftEntry> sSpellShapeshiftStore(SpellShapeshiftEntryfmt)
 DBCStorage <SpellTargetRestrictionsEntry> sSpellTargetRestrictionsStore(SpellTargetRestrictionsEntryfmt);
 DBCStorage <SpellTotemsEntry> sSpellTotemsStore(SpellTotemsEntryfmt);
 
-SpellEffectMap sSpellEffectMap;
+static std::vector<SpellInfo> sSpellInfos;                  // only spells with data, ordered by id
+static std::vector<uint32> sSpellInfoIndex;                 // spell id -> position in sSpellInfos + 1, 0 if none
 
 DBCStorage <SpellCastTimesEntry> sSpellCastTimesStore(SpellCastTimefmt);
 DBCStorage <SpellDifficultyEntry> sSpellDifficultyStore(SpellDifficultyfmt);
@@ -625,8 +627,6 @@ void LoadDBCStores(const std::string& dataPath)
                     MANGOS_ASSERT(spellEffect->EffectMiscValue >= 0 && spellEffect->EffectMiscValue < MAX_POWERS);
                     break;
             }
-
-            sSpellEffectMap[spellEffect->EffectSpellId].effects[spellEffect->EffectIndex] = spellEffect;
         }
     }
 
@@ -640,6 +640,9 @@ void LoadDBCStores(const std::string& dataPath)
     LoadDBC(availableDbcLocales,bar,bad_dbc_files,sSpellTargetRestrictionsStore, dbcPath,"SpellTargetRestrictions.dbc");
     LoadDBC(availableDbcLocales,bar,bad_dbc_files,sSpellTotemsStore,         dbcPath,"SpellTotems.dbc");
 
+    // all spell sub entries are loaded, resolve them once for every spell
+    LoadSpellInfoStore();
+
     for (uint32 j = 0; j < sSkillLineAbilityStore.GetNumRows(); ++j)
     {
         SkillLineAbilityEntry const *skillLine = sSkillLineAbilityStore.LookupEntry(j);
@@ -899,11 +902,117 @@ TalentSpellPos const* GetTalentSpellPos(uint32 spellId)
 
 SpellEffectEntry const* GetSpellEffectEntry(uint32 spellId, SpellEffectIndex effect)
 {
-    SpellEffectMap::const_iterator itr = sSpellEffectMap.find(spellId);
-    if(itr == sSpellEffectMap.end())
+    SpellInfo const* info = GetSpellInfo(spellId);
+    return info ? info->effects[effect] : NULL;
+}
+
+SpellInfo const* GetSpellInfo(uint32 spellId)
+{
+    if (spellId >= sSpellInfoIndex.size() || !sSpellInfoIndex[spellId])
         return NULL;
 
-    return itr->second.effects[effect];
+    return &sSpellInfos[sSpellInfoIndex[spellId] - 1];
+}
+
+void LoadSpellInfoStore()
+{
+    // effects may exist for ids without spell entry, GetSpellEffectEntry() always returned them
+    uint32 maxSpellId = sSpellStore.GetNumRows();
+    for (uint32 i = 1; i < sSpellEffectStore.GetNumRows(); ++i)
+        if (SpellEffectEntry const* spellEffect = sSpellEffectStore.LookupEntry(i))
+            maxSpellId = std::max(maxSpellId, spellEffect->EffectSpellId + 1);
+
+    std::vector<SpellInfo> infos;
+    std::vector<uint32> index(maxSpellId, 0);
+
+    for (uint32 id = 1; id < sSpellStore.GetNumRows(); ++id)
+    {
+        SpellEntry const* spell = sSpellStore.LookupEntry(id);
+        if (!spell)
+            continue;
+
+        SpellInfo info;
+        memset(&info, 0, sizeof(SpellInfo));
+        info.entry = spell;
+
+        info.auraOptions = spell->SpellAuraOptionsId ? sSpellAuraOptionsStore.LookupEntry(spell->SpellAuraOptionsId) : NULL;
+        info.classOptions = spell->SpellClassOptionsId ? sSpellClassOptionsStore.LookupEntry(spell->SpellClassOptionsId) : NULL;
+        info.categories = spell->SpellCategoriesId ? sSpellCategoriesStore.LookupEntry(spell->SpellCategoriesId) : NULL;
+        info.power = spell->SpellPowerId ? sSpellPowerStore.LookupEntry(spell->SpellPowerId) : NULL;
+        info.cooldowns = spell->SpellCooldownsId ? sSpellCooldownsStore.LookupEntry(spell->SpellCooldownsId) : NULL;
+        info.interrupts = spell->SpellInterruptsId ? sSpellInterruptsStore.LookupEntry(spell->SpellInterruptsId) : NULL;
+        info.auraRestrictions = spell->SpellAuraRestrictionsId ? sSpellAuraRestrictionsStore.LookupEntry(spell->SpellAuraRestrictionsId) : NULL;
+        info.castingRequirements = spell->SpellCastingRequirementsId ? sSpellCastingRequirementsStore.LookupEntry(spell->SpellCastingRequirementsId) : NULL;
+        info.targetRestrictions = spell->SpellTargetRestrictionsId ? sSpellTargetRestrictionsStore.LookupEntry(spell->SpellTargetRestrictionsId) : NULL;
+        info.equippedItems = spell->SpellEquippedItemsId ? sSpellEquippedItemsStore.LookupEntry(spell->SpellEquippedItemsId) : NULL;
+        info.levels = spell->SpellLevelsId ? sSpellLevelsStore.LookupEntry(spell->SpellLevelsId) : NULL;
+        info.reagents = spell->SpellReagentsId ? sSpellReagentsStore.LookupEntry(spell->SpellReagentsId) : NULL;
+        info.scaling = spell->SpellScalingId ? sSpellScalingStore.LookupEntry(spell->SpellScalingId) : NULL;
+        info.shapeshift = spell->SpellShapeshiftId ? sSpellShapeshiftStore.LookupEntry(spell->SpellShapeshiftId) : NULL;
+        info.totems = spell->SpellTotemsId ? sSpellTotemsStore.LookupEntry(spell->SpellTotemsId) : NULL;
+
+        if (info.auraOptions)
+        {
+            info.procFlags = info.auraOptions->procFlags;
+            info.procChance = info.auraOptions->procChance;
+            info.procCharges = info.auraOptions->procCharges;
+        }
+
+        infos.push_back(info);
+        index[id] = infos.size();
+    }
+
+    for (uint32 i = 1; i < sSpellEffectStore.GetNumRows(); ++i)
+    {
+        SpellEffectEntry const* spellEffect = sSpellEffectStore.LookupEntry(i);
+        if (!spellEffect || spellEffect->EffectIndex >= MAX_EFFECT_INDEX)
+            continue;
+
+        uint32 id = spellEffect->EffectSpellId;
+        if (!index[id])
+        {
+            SpellInfo info;
+            memset(&info, 0, sizeof(SpellInfo));
+            infos.push_back(info);
+            index[id] = infos.size();
+        }
+
+        infos[index[id] - 1].effects[spellEffect->EffectIndex] = spellEffect;
+    }
+
+    sSpellInfos.swap(infos);
+    sSpellInfoIndex.swap(index);
+
+    // derived flags need the resolved data of other spells (triggered spells), so only now
+    for (std::vector<SpellInfo>::iterator itr = sSpellInfos.begin(); itr != sSpellInfos.end(); ++itr)
+    {
+        SpellEntry const* spell = itr->entry;
+        if (!spell)
+            continue;
+
+        uint32 flags = SPELL_INFO_DERIVED;
+
+        if (IsPositiveSpell(spell))
+            flags |= SPELL_INFO_POSITIVE;
+        if (IsAreaOfEffectSpell(spell))
+            flags |= SPELL_INFO_AREA_OF_EFFECT;
+
+        for (int i = 0; i < MAX_EFFECT_INDEX; ++i)
+        {
+            SpellEffectEntry const* spellEffect = itr->effects[i];
+            if (!spellEffect)
+                continue;
+
+            if (IsPositiveEffect(spell, SpellEffectIndex(i)))
+                flags |= SPELL_INFO_POSITIVE_EFFECT_0 << i;
+            if (IsAreaEffectTarget(Targets(spellEffect->EffectImplicitTargetA)) || IsAreaEffectTarget(Targets(spellEffect->EffectImplicitTargetB)))
+                flags |= SPELL_INFO_AREA_TARGET_EFFECT_0 << i;
+            if (spellEffect->EffectApplyAuraName)
+                flags |= SPELL_INFO_HAS_AURA;
+        }
+
+        itr->flags = flags;
+    }
 }
 
 uint32 GetTalentSpellCost(TalentSpellPos const* pos)
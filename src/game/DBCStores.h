@@ -36,6 +36,9 @@ uint32 GetTalentSpellCost(uint32 spellId);
 uint32 GetTalentSpellCost(TalentSpellPos const* pos);
 TalentSpellPos const* GetTalentSpellPos(uint32 spellId);
 SpellEffectEntry const* GetSpellEffectEntry(uint32 spellId, SpellEffectIndex effect);
+SpellInfo const* GetSpellInfo(uint32 spellId);
+// (re)build the SpellInfo records of all spells, must be called again after sSpellStore changed
+void LoadSpellInfoStore();
 
 int32 GetAreaFlagByAreaID(uint32 area_id);                  // -1 if not found
 uint32 GetAreaFlagByMapId(uint32 mapid);
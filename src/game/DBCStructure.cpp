@@ -38,33 +38,57 @@ ClassFamilyMask const& SpellEntry::GetEffectSpellClassMask(SpellEffectIndex eff)
     return emptyCFM;
 }
 
+SpellInfo const* SpellEntry::GetInfo() const
+{
+    SpellInfo const* info = GetSpellInfo(Id);
+    return info && info->entry == this ? info : NULL;
+}
+
 SpellAuraOptionsEntry const* SpellEntry::GetSpellAuraOptions() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->auraOptions;
+
     return SpellAuraOptionsId ? sSpellAuraOptionsStore.LookupEntry(SpellAuraOptionsId) : NULL;
 }
 
 SpellAuraRestrictionsEntry const* SpellEntry::GetSpellAuraRestrictions() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->auraRestrictions;
+
     return SpellAuraRestrictionsId ? sSpellAuraRestrictionsStore.LookupEntry(SpellAuraRestrictionsId) : NULL;
 }
 
 SpellCastingRequirementsEntry const* SpellEntry::GetSpellCastingRequirements() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->castingRequirements;
+
     return SpellCastingRequirementsId ? sSpellCastingRequirementsStore.LookupEntry(SpellCastingRequirementsId) : NULL;
 }
 
 SpellCategoriesEntry const* SpellEntry::GetSpellCategories() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->categories;
+
     return SpellCategoriesId ? sSpellCategoriesStore.LookupEntry(SpellCategoriesId) : NULL;
 }
 
 SpellClassOptionsEntry const* SpellEntry::GetSpellClassOptions() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->classOptions;
+
     return SpellClassOptionsId ? sSpellClassOptionsStore.LookupEntry(SpellClassOptionsId) : NULL;
 }
 
 SpellCooldownsEntry const* SpellEntry::GetSpellCooldowns() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->cooldowns;
+
     return SpellCooldownsId ? sSpellCooldownsStore.LookupEntry(SpellCooldownsId) : NULL;
 }
 
@@ -75,46 +99,73 @@ SpellEffectEntry const* SpellEntry::GetSpellEffect(SpellEffectIndex eff) const
 
 SpellEquippedItemsEntry const* SpellEntry::GetSpellEquippedItems() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->equippedItems;
+
     return SpellEquippedItemsId ? sSpellEquippedItemsStore.LookupEntry(SpellEquippedItemsId) : NULL;
 }
 
 SpellInterruptsEntry const* SpellEntry::GetSpellInterrupts() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->interrupts;
+
     return SpellInterruptsId ? sSpellInterruptsStore.LookupEntry(SpellInterruptsId) : NULL;
 }
 
 SpellLevelsEntry const* SpellEntry::GetSpellLevels() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->levels;
+
     return SpellLevelsId ? sSpellLevelsStore.LookupEntry(SpellLevelsId) : NULL;
 }
 
 SpellPowerEntry const* SpellEntry::GetSpellPower() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->power;
+
     return SpellPowerId ? sSpellPowerStore.LookupEntry(SpellPowerId) : NULL;
 }
 
 SpellReagentsEntry const* SpellEntry::GetSpellReagents() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->reagents;
+
     return SpellReagentsId ? sSpellReagentsStore.LookupEntry(SpellReagentsId) : NULL;
 }
 
 SpellScalingEntry const* SpellEntry::GetSpellScaling() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->scaling;
+
     return SpellScalingId ? sSpellScalingStore.LookupEntry(SpellScalingId) : NULL;
 }
 
 SpellShapeshiftEntry const* SpellEntry::GetSpellShapeshift() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->shapeshift;
+
     return SpellShapeshiftId ? sSpellShapeshiftStore.LookupEntry(SpellShapeshiftId) : NULL;
 }
 
 SpellTargetRestrictionsEntry const* SpellEntry::GetSpellTargetRestrictions() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->targetRestrictions;
+
     return SpellTargetRestrictionsId ? sSpellTargetRestrictionsStore.LookupEntry(SpellTargetRestrictionsId) : NULL;
 }
 
 SpellTotemsEntry const* SpellEntry::GetSpellTotems() const
 {
+    if (SpellInfo const* info = GetInfo())
+        return info->totems;
+
     return SpellTotemsId ? sSpellTotemsStore.LookupEntry(SpellTotemsId) : NULL;
 }
 
@@ -1925,6 +1925,8 @@ struct SpellTotemsEntry
     uint32    Totem[MAX_SPELL_TOTEMS];                      // 52-53    m_totem
 };
 
+struct SpellInfo;
+
 // Spell.dbc
 struct MANGOS_DLL_SPEC SpellEntry
 {
@@ -1980,6 +1982,9 @@ struct MANGOS_DLL_SPEC SpellEntry
     int32 CalculateSimpleValue(SpellEffectIndex eff) const;
     ClassFamilyMask const& GetEffectSpellClassMask(SpellEffectIndex eff) const;
 
+    // resolved data of this entry, NULL before LoadSpellInfoStore() and for entries not in sSpellStore
+    SpellInfo const* GetInfo() const;
+
     // struct access functions
     SpellAuraOptionsEntry const* GetSpellAuraOptions() const;
     SpellAuraRestrictionsEntry const* GetSpellAuraRestrictions() const;
@@ -2500,18 +2505,54 @@ struct TalentSpellPos
 
 typedef std::map<uint32,TalentSpellPos> TalentSpellPosMap;
 
-struct SpellEffect
+enum SpellInfoFlags
 {
-    SpellEffect()
-    {
-        effects[0] = NULL;
-        effects[1] = NULL;
-        effects[2] = NULL;
-    }
-    SpellEffectEntry const* effects[3];
+    SPELL_INFO_DERIVED              = 0x00000001,           // flags below are filled
+    SPELL_INFO_POSITIVE             = 0x00000002,           // IsPositiveSpell()
+    SPELL_INFO_AREA_OF_EFFECT       = 0x00000004,           // IsAreaOfEffectSpell()
+    SPELL_INFO_HAS_AURA             = 0x00000008,           // at least one effect applies an aura
+    SPELL_INFO_POSITIVE_EFFECT_0    = 0x00000010,           // IsPositiveEffect() for effect 0, << index for the others
+    SPELL_INFO_AREA_TARGET_EFFECT_0 = 0x00000100,           // effect 0 has an area target, << index for the others
 };
 
-typedef std::map<uint32, SpellEffect> SpellEffectMap;
+/**
+ * Spell data resolved once after loading: the sub entries of the spell, its effects and some
+ * derived flags, in one record per spell instead of a store lookup for every access.
+ * Built by LoadSpellInfoStore(), see GetSpellInfo() and SpellEntry::GetInfo().
+ */
+struct SpellInfo
+{
+    SpellEntry const* entry;                                // NULL for effects without spell
+    SpellEffectEntry const* effects[MAX_EFFECT_INDEX];
+
+    SpellAuraOptionsEntry const* auraOptions;
+    SpellClassOptionsEntry const* classOptions;
+    SpellCategoriesEntry const* categories;
+    SpellPowerEntry const* power;
+    SpellCooldownsEntry const* cooldowns;
+    SpellInterruptsEntry const* interrupts;
+    SpellAuraRestrictionsEntry const* auraRestrictions;
+    SpellCastingRequirementsEntry const* castingRequirements;
+    SpellTargetRestrictionsEntry const* targetRestrictions;
+    SpellEquippedItemsEntry const* equippedItems;
+    SpellLevelsEntry const* levels;
+    SpellReagentsEntry const* reagents;
+    SpellScalingEntry const* scaling;
+    SpellShapeshiftEntry const* shapeshift;
+    SpellTotemsEntry const* totems;
+
+    uint32 flags;                                           // SpellInfoFlags
+    uint32 procFlags;                                       // from SpellAuraOptions.dbc, not spell_proc_event
+    uint32 procChance;
+    uint32 procCharges;
+
+    bool HasDerivedFlags() const { return flags & SPELL_INFO_DERIVED; }
+    bool IsPositive() const { return flags & SPELL_INFO_POSITIVE; }
+    bool IsPositiveEffect(SpellEffectIndex eff) const { return flags & (SPELL_INFO_POSITIVE_EFFECT_0 << eff); }
+    bool IsAreaOfEffect() const { return flags & SPELL_INFO_AREA_OF_EFFECT; }
+    bool HasAreaTarget(SpellEffectIndex eff) const { return flags & (SPELL_INFO_AREA_TARGET_EFFECT_0 << eff); }
+    bool HasAura() const { return flags & SPELL_INFO_HAS_AURA; }
+};
 
 struct TaxiPathBySourceAndDestination
 {
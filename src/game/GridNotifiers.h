@@ -21,6 +21,7 @@
 
 #include "ObjectGridLoader.h"
 #include "UpdateData.h"
+#include "SharedWorldPacket.h"
 #include <iostream>
 
 #include "Corpse.h"
@@ -57,9 +58,9 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL MessageDeliverer
     {
         Player const& i_player;
-        WorldPacket* i_message;
+        SharedWorldPacket i_message;
         bool i_toSelf;
-        MessageDeliverer(Player const& pl, WorldPacket* msg, bool to_self) : i_player(pl), i_message(msg), i_toSelf(to_self) {}
+        MessageDeliverer(Player const& pl, WorldPacket* msg, bool to_self) : i_player(pl), i_message(*msg), i_toSelf(to_self) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
@@ -67,11 +68,11 @@ namespace MaNGOS
     struct MessageDelivererExcept
     {
         uint32        i_phaseMask;
-        WorldPacket*  i_message;
+        SharedWorldPacket i_message;
         Player const* i_skipped_receiver;
 
         MessageDelivererExcept(WorldObject const* obj, WorldPacket* msg, Player const* skipped)
-            : i_phaseMask(obj->GetPhaseMask()), i_message(msg), i_skipped_receiver(skipped) {}
+            : i_phaseMask(obj->GetPhaseMask()), i_message(*msg), i_skipped_receiver(skipped) {}
 
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
@@ -80,9 +81,9 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL ObjectMessageDeliverer
     {
         uint32 i_phaseMask;
-        WorldPacket* i_message;
+        SharedWorldPacket i_message;
         explicit ObjectMessageDeliverer(WorldObject const& obj, WorldPacket* msg)
-            : i_phaseMask(obj.GetPhaseMask()), i_message(msg) {}
+            : i_phaseMask(obj.GetPhaseMask()), i_message(*msg) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
@@ -90,13 +91,13 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL MessageDistDeliverer
     {
         Player const& i_player;
-        WorldPacket* i_message;
+        SharedWorldPacket i_message;
         bool i_toSelf;
         bool i_ownTeamOnly;
         float i_dist;
 
         MessageDistDeliverer(Player const& pl, WorldPacket* msg, float dist, bool to_self, bool ownTeamOnly)
-            : i_player(pl), i_message(msg), i_toSelf(to_self), i_ownTeamOnly(ownTeamOnly), i_dist(dist) {}
+            : i_player(pl), i_message(*msg), i_toSelf(to_self), i_ownTeamOnly(ownTeamOnly), i_dist(dist) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
@@ -104,9 +105,9 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL ObjectMessageDistDeliverer
     {
         WorldObject const& i_object;
-        WorldPacket* i_message;
+        SharedWorldPacket i_message;
         float i_dist;
-        ObjectMessageDistDeliverer(WorldObject const& obj, WorldPacket* msg, float dist) : i_object(obj), i_message(msg), i_dist(dist) {}
+        ObjectMessageDistDeliverer(WorldObject const& obj, WorldPacket* msg, float dist) : i_object(obj), i_message(*msg), i_dist(dist) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
@@ -1282,7 +1282,7 @@ void Item::RemoveFromClientUpdateList()
         pl->GetMap()->RemoveUpdateObject(this);
 }
 
-void Item::BuildUpdateData(UpdateDataMapType& update_players)
+void Item::BuildUpdateData(UpdateDataBatch& update_players)
 {
     if (Player* pl = GetOwner())
         BuildUpdateDataForPlayer(pl, update_players);
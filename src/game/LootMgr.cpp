@@ -98,8 +98,8 @@ void LootStore::LoadLootTable()
     // Clearing store (for reloading case)
     Clear();
 
-    //                                                 0      1     2                    3        4              5         6
-    QueryResult* result = WorldDatabase.PQuery("SELECT entry, item, ChanceOrQuestChance, groupid, mincountOrRef, maxcount, condition_id FROM %s", GetName());
+    //                                                       0      1     2                    3        4              5         6
+    QueryResult* result = WorldDatabase.PStreamQuery("SELECT entry, item, ChanceOrQuestChance, groupid, mincountOrRef, maxcount, condition_id FROM %s", GetName());
 
     if (result)
     {
@@ -167,6 +167,17 @@ void LootStore::LoadLootTable()
         }
         while (result->NextRow());
 
+        // same as a failed stored query: nothing is loaded
+        if (result->IsIncomplete())
+        {
+            delete result;
+            Clear();
+
+            sLog.outString();
+            sLog.outErrorDb(">> Loaded 0 loot definitions. DB table `%s` could not be read completely.", GetName());
+            return;
+        }
+
         delete result;
 
         Verify();                                           // Checks validity of the loot store
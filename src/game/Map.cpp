@@ -76,7 +76,8 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
       m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(NULL),
       m_activeNonPlayersIter(m_activeNonPlayers.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
-      i_data(NULL), i_script_id(0)
+      i_data(NULL), i_script_id(0),
+      m_lastUpdateTime(0), m_maxUpdateTime(0), m_avgUpdateTime(0)
 {
     m_CreatureGuids.Set(sObjectMgr.GetFirstTemporaryCreatureLowGuid());
     m_GameObjectGuids.Set(sObjectMgr.GetFirstTemporaryGameObjectLowGuid());
@@ -542,6 +543,15 @@ void Map::Update(const uint32& t_diff)
         }
     }
 
+    // visibility of moved units, before their changes are sent
+    m_relocationTimer.Update(t_diff);
+    if (m_relocationTimer.Passed())
+    {
+        m_relocationTimer.SetInterval(World::GetRelocationVisibilityInterval());
+        m_relocationTimer.SetCurrent(0);
+        ProcessRelocatedUnits();
+    }
+
     // Send world objects and item update field changes
     SendObjectUpdates();
 
@@ -877,6 +887,17 @@ const char* Map::GetMapName() const
     return i_mapEntry ? i_mapEntry->name[sWorld.GetDefaultDbcLocale()] : "UNNAMEDMAP\x0";
 }
 
+void Map::SetUpdateTime(uint32 updateTime)
+{
+    m_lastUpdateTime = updateTime;
+
+    if (updateTime > m_maxUpdateTime)
+        m_maxUpdateTime = updateTime;
+
+    // moving average over the last ~16 ticks, enough to smooth out single spikes
+    m_avgUpdateTime = m_avgUpdateTime ? (m_avgUpdateTime * 15 + updateTime) / 16 : updateTime;
+}
+
 void Map::UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair)
 {
     cell.SetNoCreate();
@@ -1825,24 +1846,53 @@ WorldObject* Map::GetWorldObject(ObjectGuid guid)
     return NULL;
 }
 
-void Map::SendObjectUpdates()
+void Map::AddRelocatedUnit(Unit* unit)
 {
-    UpdateDataMapType update_players;
+    uint32 slot = unit->m_relocationQueueSlot;
+    if (slot < i_relocatedUnits.size() && i_relocatedUnits[slot] == unit)
+        return;                                             // already queued, moves are folded
+
+    unit->m_relocationQueueSlot = i_relocatedUnits.size();
+    i_relocatedUnits.push_back(unit);
+}
 
-    while (!i_objectsToClientUpdate.empty())
+void Map::RemoveRelocatedUnit(Unit* unit)
+{
+    uint32 slot = unit->m_relocationQueueSlot;
+    if (slot < i_relocatedUnits.size() && i_relocatedUnits[slot] == unit)
+        i_relocatedUnits[slot] = NULL;
+}
+
+void Map::ProcessRelocatedUnits()
+{
+    // size re-evaluated each step, visibility updates can move and queue units again
+    for (size_t i = 0; i < i_relocatedUnits.size(); ++i)
     {
-        Object* obj = *i_objectsToClientUpdate.begin();
-        i_objectsToClientUpdate.erase(i_objectsToClientUpdate.begin());
-        obj->BuildUpdateData(update_players);
+        if (Unit* unit = i_relocatedUnits[i])
+        {
+            i_relocatedUnits[i] = NULL;
+            unit->UpdateVisibilityAfterRelocation();
+        }
     }
 
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
-    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    i_relocatedUnits.clear();
+}
+
+void Map::SendObjectUpdates()
+{
+    // size re-evaluated each step, objects can be queued again while their changes are built
+    for (size_t i = 0; i < i_objectsToClientUpdate.size(); ++i)
     {
-        iter->second.BuildPacket(&packet);
-        iter->first->GetSession()->SendPacket(&packet);
-        packet.clear();                                     // clean the string
+        if (Object* obj = i_objectsToClientUpdate[i])
+        {
+            i_objectsToClientUpdate[i] = NULL;
+            obj->BuildUpdateData(i_clientUpdateBatch);
+        }
     }
+
+    i_objectsToClientUpdate.clear();
+
+    i_clientUpdateBatch.SendAndClear();
 }
 
 uint32 Map::GenerateLocalLowGuid(GuidType guidhigh)
@@ -38,6 +38,7 @@
 #include "ScriptMgr.h"
 #include "CreatureLinkingMgr.h"
 #include "vmap/DynamicTree.h"
+#include "MapPositionIndex.h"
 
 #include <bitset>
 #include <list>
@@ -129,6 +130,11 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
         void MessageDistBroadcast(WorldObject const*, WorldPacket*, float dist);
 
         float GetVisibilityDistance() const { return m_VisibleDistance; }
+        // units in world by position, for range queries
+        MapPositionIndex& GetPositionIndex() { return m_positionIndex; }
+        MapPositionIndex const& GetPositionIndex() const { return m_positionIndex; }
+        // scratch arrays for queries over the position index, see SpellAreaQuery
+        MapQueryBuffer& GetQueryBuffer() { return m_queryBuffer; }
         // function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
 
@@ -248,14 +254,22 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
 
         void AddUpdateObject(Object* obj)
         {
-            i_objectsToClientUpdate.insert(obj);
+            obj->m_clientUpdateSlot = i_objectsToClientUpdate.size();
+            i_objectsToClientUpdate.push_back(obj);
         }
 
         void RemoveUpdateObject(Object* obj)
         {
-            i_objectsToClientUpdate.erase(obj);
+            // only forget the object, the slot is skipped at SendObjectUpdates
+            uint32 slot = obj->m_clientUpdateSlot;
+            if (slot < i_objectsToClientUpdate.size() && i_objectsToClientUpdate[slot] == obj)
+                i_objectsToClientUpdate[slot] = NULL;
         }
 
+        // queue unit for the next relocation visibility batch, once per batch
+        void AddRelocatedUnit(Unit* unit);
+        void RemoveRelocatedUnit(Unit* unit);
+
         // DynObjects currently
         uint32 GenerateLocalLowGuid(GuidType guidhigh);
 
@@ -286,6 +300,12 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
         // Teleport all players in that map to choosed location
         void TeleportAllPlayersTo(TeleportLocation loc);
 
+        // Tick duration statistics (in ms), filled by MapUpdater::UpdateMap
+        void SetUpdateTime(uint32 updateTime);
+        uint32 GetLastUpdateTime() const { return m_lastUpdateTime; }
+        uint32 GetMaxUpdateTime() const { return m_maxUpdateTime; }
+        uint32 GetAvgUpdateTime() const { return m_avgUpdateTime; }
+
     private:
         void LoadMapAndVMap(int gx, int gy);
 
@@ -322,7 +342,18 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
         void ScriptsProcess();
 
         void SendObjectUpdates();
-        std::set<Object*> i_objectsToClientUpdate;
+        void ProcessRelocatedUnits();
+
+        typedef std::vector<Object*> ClientUpdateQueue;
+        ClientUpdateQueue i_objectsToClientUpdate;          // objects in order of AddUpdateObject, removed ones are NULL
+        UpdateDataBatch i_clientUpdateBatch;                // reused by every SendObjectUpdates
+
+        typedef std::vector<Unit*> RelocationQueue;
+        RelocationQueue i_relocatedUnits;                   // units moved since last ProcessRelocatedUnits, removed ones are NULL
+        ShortIntervalTimer m_relocationTimer;
+
+        MapPositionIndex m_positionIndex;
+        MapQueryBuffer m_queryBuffer;
 
     protected:
         MapEntry const* i_mapEntry;
@@ -379,6 +410,11 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
 
         // Dynamic Map tree object
         DynamicMapTree m_dyn_tree;
+
+        // Tick duration statistics
+        uint32 m_lastUpdateTime;
+        uint32 m_maxUpdateTime;
+        uint32 m_avgUpdateTime;
 };
 
 class MANGOS_DLL_SPEC WorldMap : public Map
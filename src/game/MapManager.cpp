@@ -27,19 +27,22 @@
 #include "CellImpl.h"
 #include "Corpse.h"
 #include "ObjectMgr.h"
+#include "Timer.h"
 
 #define CLASS_LOCK MaNGOS::ClassLevelLockable<MapManager, ACE_Recursive_Thread_Mutex>
 INSTANTIATE_SINGLETON_2(MapManager, CLASS_LOCK);
 INSTANTIATE_CLASS_MUTEX(MapManager, ACE_Recursive_Thread_Mutex);
 
 MapManager::MapManager()
-    : i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN))
+    : i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN)), i_lastUpdateTime(0)
 {
     i_timer.SetInterval(sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
 }
 
 MapManager::~MapManager()
 {
+    i_updater.Deactivate();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         delete iter->second;
 
@@ -53,6 +56,14 @@ void
 MapManager::Initialize()
 {
     InitStateMachine();
+
+    if (uint32 numThreads = sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_THREADS))
+    {
+        if (i_updater.Activate(numThreads) == -1)
+            sLog.outError("MapManager: failed to start map update threads, maps will be updated by the world thread");
+        else
+            sLog.outString("MapManager: using %u threads for map updates", numThreads);
+    }
 }
 
 void MapManager::InitStateMachine()
@@ -173,8 +184,28 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
-    for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
-        iter->second->Update((uint32)i_timer.GetCurrent());
+    uint32 startTime = WorldTimer::getMSTime();
+
+    if (i_updater.IsActive())
+    {
+        {
+            // maps can be created from worker threads (instance enter), don't let them change the container while scheduling
+            Guard _guard(*this);
+
+            for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+                i_updater.ScheduleUpdate(*iter->second, (uint32)i_timer.GetCurrent());
+        }
+
+        // all maps must be done before transports, unloading and battleground manager run
+        i_updater.Wait();
+    }
+    else
+    {
+        for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+            MapUpdater::UpdateMap(*iter->second, (uint32)i_timer.GetCurrent());
+    }
+
+    i_lastUpdateTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
 
     for (TransportSet::iterator iter = m_Transports.begin(); iter != m_Transports.end(); ++iter)
     {
@@ -227,6 +258,8 @@ bool MapManager::IsValidMAP(uint32 mapid)
 
 void MapManager::UnloadAll()
 {
+    i_updater.Deactivate();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->UnloadAll(true);
 
@@ -25,6 +25,7 @@
 #include "ace/Recursive_Thread_Mutex.h"
 #include "Map.h"
 #include "GridStates.h"
+#include "MapUpdater.h"
 
 class Transport;
 class BattleGround;
@@ -129,6 +130,8 @@ class MANGOS_DLL_DECL MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::
         /* statistics */
         uint32 GetNumInstances();
         uint32 GetNumPlayersInInstances();
+        uint32 GetMapUpdateThreads() const { return i_updater.GetThreadCount(); }
+        uint32 GetLastUpdateTime() const { return i_lastUpdateTime; }   // duration of last maps update phase (ms)
 
         // get list of all maps
         const MapMapType& Maps() const { return i_maps; }
@@ -160,6 +163,8 @@ class MANGOS_DLL_DECL MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::
         uint32 i_gridCleanUpDelay;
         MapMapType i_maps;
         IntervalTimer i_timer;
+        MapUpdater i_updater;
+        uint32 i_lastUpdateTime;
 };
 
 template<typename Do>
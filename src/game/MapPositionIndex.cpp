@@ -0,0 +1,152 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MapPositionIndex.h"
+#include "Object.h"
+#include "GridDefines.h"
+
+uint32 MapPositionIndex::GetCellKey(float x, float y)
+{
+    CellPair p = MaNGOS::ComputeCellPair(x, y).normalize();
+    return p.x_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP + p.y_coord;
+}
+
+void MapPositionIndex::Insert(WorldObject* obj)
+{
+    if (obj->m_positionIndexCell != NOT_INDEXED)
+        return;
+
+    AddToBucket(obj, GetCellKey(obj->GetPositionX(), obj->GetPositionY()));
+    ++m_size;
+}
+
+void MapPositionIndex::Remove(WorldObject* obj)
+{
+    if (obj->m_positionIndexCell == NOT_INDEXED)
+        return;
+
+    RemoveFromBucket(obj);
+    --m_size;
+}
+
+void MapPositionIndex::Relocate(WorldObject* obj)
+{
+    uint32 key = GetCellKey(obj->GetPositionX(), obj->GetPositionY());
+
+    if (key != obj->m_positionIndexCell)
+    {
+        RemoveFromBucket(obj);
+        AddToBucket(obj, key);
+        return;
+    }
+
+    Bucket& bucket = m_buckets[key];
+    uint32 slot = obj->m_positionIndexSlot;
+
+    bucket.m_x[slot] = obj->GetPositionX();
+    bucket.m_y[slot] = obj->GetPositionY();
+    bucket.m_z[slot] = obj->GetPositionZ();
+    bucket.m_boundingRadius[slot] = obj->GetObjectBoundingRadius();
+
+    m_maxBoundingRadius = std::max(m_maxBoundingRadius, obj->GetObjectBoundingRadius());
+}
+
+void MapPositionIndex::AddToBucket(WorldObject* obj, uint32 key)
+{
+    Bucket& bucket = m_buckets[key];
+
+    obj->m_positionIndexCell = key;
+    obj->m_positionIndexSlot = bucket.m_objects.size();
+
+    bucket.m_x.push_back(obj->GetPositionX());
+    bucket.m_y.push_back(obj->GetPositionY());
+    bucket.m_z.push_back(obj->GetPositionZ());
+    bucket.m_boundingRadius.push_back(obj->GetObjectBoundingRadius());
+    bucket.m_typeMask.push_back(obj->GetTypeMask());
+    bucket.m_objects.push_back(obj);
+
+    m_maxBoundingRadius = std::max(m_maxBoundingRadius, obj->GetObjectBoundingRadius());
+}
+
+void MapPositionIndex::RemoveFromBucket(WorldObject* obj)
+{
+    Bucket& bucket = m_buckets[obj->m_positionIndexCell];
+    uint32 slot = obj->m_positionIndexSlot;
+    uint32 last = bucket.m_objects.size() - 1;
+
+    // fill the hole with the last entry to keep the arrays dense
+    if (slot != last)
+    {
+        bucket.m_x[slot] = bucket.m_x[last];
+        bucket.m_y[slot] = bucket.m_y[last];
+        bucket.m_z[slot] = bucket.m_z[last];
+        bucket.m_boundingRadius[slot] = bucket.m_boundingRadius[last];
+        bucket.m_typeMask[slot] = bucket.m_typeMask[last];
+        bucket.m_objects[slot] = bucket.m_objects[last];
+        bucket.m_objects[slot]->m_positionIndexSlot = slot;
+    }
+
+    bucket.m_x.pop_back();
+    bucket.m_y.pop_back();
+    bucket.m_z.pop_back();
+    bucket.m_boundingRadius.pop_back();
+    bucket.m_typeMask.pop_back();
+    bucket.m_objects.pop_back();
+
+    obj->m_positionIndexCell = NOT_INDEXED;
+    obj->m_positionIndexSlot = 0;
+}
+
+void MapPositionIndex::GetObjectsInRange(float x, float y, float z, float radius, uint32 typeMask, bool is3D, std::vector<WorldObject*>& result) const
+{
+    float searchRadius = radius + m_maxBoundingRadius;
+
+    CellPair low = MaNGOS::ComputeCellPair(x - searchRadius, y - searchRadius).normalize();
+    CellPair high = MaNGOS::ComputeCellPair(x + searchRadius, y + searchRadius).normalize();
+
+    for (uint32 cellX = low.x_coord; cellX <= high.x_coord; ++cellX)
+    {
+        for (uint32 cellY = low.y_coord; cellY <= high.y_coord; ++cellY)
+        {
+            BucketMap::const_iterator itr = m_buckets.find(cellX * TOTAL_NUMBER_OF_CELLS_PER_MAP + cellY);
+            if (itr == m_buckets.end())
+                continue;
+
+            Bucket const& bucket = itr->second;
+
+            // plain loops over the coordinate arrays, kept branch free for the compiler to vectorize
+            float const* posX = bucket.m_x.empty() ? NULL : &bucket.m_x[0];
+            float const* posY = bucket.m_y.empty() ? NULL : &bucket.m_y[0];
+            float const* posZ = bucket.m_z.empty() ? NULL : &bucket.m_z[0];
+            float const* boundingRadius = bucket.m_boundingRadius.empty() ? NULL : &bucket.m_boundingRadius[0];
+            uint32 const* mask = bucket.m_typeMask.empty() ? NULL : &bucket.m_typeMask[0];
+            size_t count = bucket.m_objects.size();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                float dx = posX[i] - x;
+                float dy = posY[i] - y;
+                float dz = is3D ? posZ[i] - z : 0.0f;
+                float maxDist = radius + boundingRadius[i];
+
+                if (dx * dx + dy * dy + dz * dz <= maxDist * maxDist && (mask[i] & typeMask))
+                    result.push_back(bucket.m_objects[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAPPOSITIONINDEX_H
+#define MANGOS_MAPPOSITIONINDEX_H
+
+#include "Common.h"
+#include "Platform/Define.h"
+
+#include <vector>
+
+class WorldObject;
+class Unit;
+
+/**
+ * Per map position index of the units in world, used for range queries.
+ *
+ * Units are hashed by grid cell. Every cell bucket keeps positions, type masks
+ * and objects in separate contiguous arrays, so a range query is a plain distance
+ * filter over floats instead of a walk over the GridRefManager lists of each cell.
+ * Entries are kept up to date by WorldObject::Relocate(), the index must only be
+ * used from the thread updating the owning map.
+ */
+class MapPositionIndex
+{
+    public:
+        MapPositionIndex() : m_size(0), m_maxBoundingRadius(0.0f) {}
+
+        void Insert(WorldObject* obj);
+        void Remove(WorldObject* obj);
+        // refresh stored position and bounding radius of an indexed object
+        void Relocate(WorldObject* obj);
+
+        // append objects matching typeMask within radius of the point, like WorldObject::IsWithinDist
+        // the radius is extended by the bounding radius of each object, but not checked against phase or map
+        void GetObjectsInRange(float x, float y, float z, float radius, uint32 typeMask, bool is3D, std::vector<WorldObject*>& result) const;
+
+        uint32 GetSize() const { return m_size; }
+        uint32 GetBucketCount() const { return m_buckets.size(); }
+
+        static const uint32 NOT_INDEXED = uint32(-1);
+
+    private:
+        struct Bucket
+        {
+            std::vector<float> m_x;
+            std::vector<float> m_y;
+            std::vector<float> m_z;
+            std::vector<float> m_boundingRadius;
+            std::vector<uint32> m_typeMask;
+            std::vector<WorldObject*> m_objects;
+        };
+
+        typedef UNORDERED_MAP<uint32, Bucket> BucketMap;
+
+        static uint32 GetCellKey(float x, float y);
+
+        void AddToBucket(WorldObject* obj, uint32 key);
+        void RemoveFromBucket(WorldObject* obj);
+
+        BucketMap m_buckets;
+        uint32 m_size;
+        float m_maxBoundingRadius;                          // widens the searched cell area, never shrinks
+};
+
+/**
+ * Scratch arrays for queries over the position index, owned by the map so that
+ * target selection doesn't allocate once the arrays reached their usual size.
+ */
+struct MapQueryBuffer
+{
+    MapQueryBuffer() : m_inUse(false) {}
+
+    std::vector<WorldObject*> m_candidates;                 // raw range query result
+    std::vector<Unit*> m_units;                             // accepted units
+    bool m_inUse;                                           // taken by a running query, nested queries use own arrays
+};
+
+#endif
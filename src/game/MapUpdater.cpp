@@ -0,0 +1,139 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MapUpdater.h"
+#include "Map.h"
+#include "Log.h"
+#include "Timer.h"
+#include "Database/DatabaseEnv.h"
+
+MapUpdater::MapUpdater() :
+    m_requestCondition(m_lock), m_doneCondition(m_lock),
+    m_pendingRequests(0), m_threadCount(0), m_cancelled(false)
+{
+}
+
+MapUpdater::~MapUpdater()
+{
+    Deactivate();
+}
+
+int MapUpdater::Activate(uint32 numThreads)
+{
+    if (IsActive() || !numThreads)
+        return -1;
+
+    m_cancelled = false;
+
+    if (activate(THR_NEW_LWP | THR_JOINABLE, int(numThreads)) == -1)
+    {
+        sLog.outError("MapUpdater: can't create %u map update threads", numThreads);
+        return -1;
+    }
+
+    m_threadCount = numThreads;
+    return 0;
+}
+
+void MapUpdater::Deactivate()
+{
+    if (!IsActive())
+        return;
+
+    // let already scheduled maps finish their tick first
+    Wait();
+
+    {
+        LOCK_GUARD guard(m_lock);
+        m_cancelled = true;
+        m_requestCondition.broadcast();
+    }
+
+    ACE_Task_Base::wait();
+    m_threadCount = 0;
+}
+
+void MapUpdater::ScheduleUpdate(Map& map, uint32 diff)
+{
+    LOCK_GUARD guard(m_lock);
+
+    m_requests.push_back(MapUpdateRequest(&map, diff));
+    ++m_pendingRequests;
+
+    m_requestCondition.signal();
+}
+
+void MapUpdater::Wait()
+{
+    LOCK_GUARD guard(m_lock);
+
+    while (m_pendingRequests > 0)
+        m_doneCondition.wait();
+}
+
+void MapUpdater::UpdateMap(Map& map, uint32 diff)
+{
+    uint32 startTime = WorldTimer::getMSTime();
+
+    map.Update(diff);
+
+    map.SetUpdateTime(WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
+}
+
+int MapUpdater::svc()
+{
+    // let thread do safe mySQL requests, map scripts and handlers may use all of them
+    WorldDatabase.ThreadStart();
+    CharacterDatabase.ThreadStart();
+    LoginDatabase.ThreadStart();
+
+    for (;;)
+    {
+        Map* map = NULL;
+        uint32 diff = 0;
+
+        {
+            LOCK_GUARD guard(m_lock);
+
+            while (m_requests.empty() && !m_cancelled)
+                m_requestCondition.wait();
+
+            if (m_requests.empty())
+                break;                                      // cancelled and nothing left to do
+
+            map = m_requests.front().m_map;
+            diff = m_requests.front().m_diff;
+            m_requests.pop_front();
+        }
+
+        UpdateMap(*map, diff);
+
+        {
+            LOCK_GUARD guard(m_lock);
+
+            if (--m_pendingRequests == 0)
+                m_doneCondition.broadcast();
+        }
+    }
+
+    LoginDatabase.ThreadEnd();
+    CharacterDatabase.ThreadEnd();
+    WorldDatabase.ThreadEnd();
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAPUPDATER_H
+#define MANGOS_MAPUPDATER_H
+
+#include "Common.h"
+#include "Platform/Define.h"
+
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include <deque>
+
+class Map;
+
+/**
+ * Worker pool used by MapManager to update independent maps concurrently.
+ *
+ * The world thread queues one request per map with ScheduleUpdate() and then
+ * blocks in Wait() until every queued map finished its tick, so everything done
+ * after Wait() (transports, map unloading, battleground manager) still sees a
+ * quiet map set.
+ */
+class MapUpdater : protected ACE_Task_Base
+{
+    public:
+        MapUpdater();
+        virtual ~MapUpdater();
+
+        // spawn numThreads worker threads, 0 keeps the updater inactive
+        int Activate(uint32 numThreads);
+        // stop and join all worker threads
+        void Deactivate();
+        bool IsActive() const { return m_threadCount > 0; }
+        uint32 GetThreadCount() const { return m_threadCount; }
+
+        // queue a map for update by one of the workers
+        void ScheduleUpdate(Map& map, uint32 diff);
+        // block until all scheduled updates are done
+        void Wait();
+
+        // update map in the calling thread and store its tick time
+        static void UpdateMap(Map& map, uint32 diff);
+
+    protected:
+        int svc() override;
+
+    private:
+        struct MapUpdateRequest
+        {
+            MapUpdateRequest(Map* map, uint32 diff) : m_map(map), m_diff(diff) {}
+
+            Map* m_map;
+            uint32 m_diff;
+        };
+
+        typedef std::deque<MapUpdateRequest> RequestQueue;
+
+        typedef ACE_Thread_Mutex LOCK_TYPE;
+        typedef ACE_Guard<LOCK_TYPE> LOCK_GUARD;
+
+        LOCK_TYPE m_lock;
+        ACE_Condition_Thread_Mutex m_requestCondition;      // signaled when a request was queued or at deactivate
+        ACE_Condition_Thread_Mutex m_doneCondition;         // signaled when the last pending request finished
+
+        RequestQueue m_requests;
+        uint32 m_pendingRequests;                           // queued + in progress requests
+        uint32 m_threadCount;
+        bool m_cancelled;
+};
+
+#endif
@@ -55,6 +55,10 @@ Object::Object()
 
     m_inWorld           = false;
     m_objectUpdated     = false;
+    m_clientUpdateSlot  = 0;
+
+    m_valuesUpdateCache   = NULL;
+    m_valuesUpdateVersion = 1;
 }
 
 Object::~Object()
@@ -73,6 +77,7 @@ Object::~Object()
     }
 
     delete[] m_uint32Values;
+    delete m_valuesUpdateCache;
 }
 
 void Object::_InitValues()
@@ -106,18 +111,12 @@ void Object::SendForcedObjectUpdate()
     if (!m_inWorld || !m_objectUpdated)
         return;
 
-    UpdateDataMapType update_players;
+    UpdateDataBatch update_players;
 
     BuildUpdateData(update_players);
     RemoveFromClientUpdateList();
 
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
-    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
-    {
-        iter->second.BuildPacket(&packet);
-        iter->first->GetSession()->SendPacket(&packet);
-        packet.clear();                                     // clean the string
-    }
+    update_players.SendAndClear();
 }
 
 void Object::BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) const
@@ -210,21 +209,106 @@ void Object::SendCreateUpdateToPlayer(Player* player)
 }
 
 void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const
+{
+    BuildValuesUpdateBlockForPlayer(data, target, CanCacheValuesUpdate());
+}
+
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, bool useCache) const
 {
     ByteBuffer buf(500);
 
     buf << uint8(UPDATETYPE_VALUES);
     buf << GetPackGUID();
 
-    UpdateMask updateMask;
-    updateMask.SetCount(m_valuesCount);
+    // viewers of same class get the same block, build it only once for current field changes
+    if (useCache)
+    {
+        if (!m_valuesUpdateCache)
+            m_valuesUpdateCache = new ValuesUpdateCache;
+
+        UpdateViewerClass viewerClass = GetUpdateViewerClass(target);
+        ByteBuffer& block = m_valuesUpdateCache->m_block[viewerClass];
+
+        if (m_valuesUpdateCache->m_version[viewerClass] != m_valuesUpdateVersion)
+        {
+            UpdateMask updateMask;
+            updateMask.SetCount(m_valuesCount);
+
+            block.clear();
+            _SetUpdateBits(&updateMask, target);
+            BuildValuesUpdate(UPDATETYPE_VALUES, &block, &updateMask, target);
+
+            m_valuesUpdateCache->m_version[viewerClass] = m_valuesUpdateVersion;
+        }
 
-    _SetUpdateBits(&updateMask, target);
-    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
+        buf.append(block);
+    }
+    else
+    {
+        UpdateMask updateMask;
+        updateMask.SetCount(m_valuesCount);
+
+        _SetUpdateBits(&updateMask, target);
+        BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
+    }
 
     data->AddUpdateBlock(buf);
 }
 
+bool Object::BuildFullValuesUpdateBlocks(std::vector<Player*> const& viewers, bool shared, UpdateDataBatch& update_players)
+{
+    std::vector<bool> changedValues(m_valuesCount);
+    m_changedValues.swap(changedValues);
+
+    for (uint16 index = 0; index < m_valuesCount; ++index)
+        m_changedValues[index] = m_uint32Values[index] != 0;
+
+    // blocks of an earlier call are outdated
+    InvalidateValuesUpdateCache();
+
+    bool useCache = shared && CanCacheValuesUpdate();
+    for (std::vector<Player*>::const_iterator itr = viewers.begin(); itr != viewers.end(); ++itr)
+        BuildValuesUpdateBlockForPlayer(&update_players.GetUpdateData(*itr), *itr, useCache);
+
+    m_changedValues.swap(changedValues);
+    InvalidateValuesUpdateCache();
+
+    return useCache;
+}
+
+bool Object::CanCacheValuesUpdate() const
+{
+    // only one viewer, nothing to share
+    if (isType(TYPEMASK_ITEM))
+        return false;
+
+    // all fields below are sent with viewer specific values by BuildValuesUpdate, except UNIT_FIELD_FLAGS that differs only for GMs
+    if (isType(TYPEMASK_UNIT))
+    {
+        if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
+            return false;
+
+        if (GetTypeId() == TYPEID_UNIT && (m_changedValues[UNIT_NPC_FLAGS] || m_changedValues[UNIT_DYNAMIC_FLAGS]))
+            return false;
+    }
+    else if (isType(TYPEMASK_GAMEOBJECT))
+    {
+        // GAMEOBJECT_DYNAMIC is always sent and depends on viewer quests
+        if (!((GameObject*)this)->IsTransport())
+            return false;
+    }
+
+    return true;
+}
+
+UpdateViewerClass Object::GetUpdateViewerClass(Player const* target) const
+{
+    if (target == this)
+        return UPDATE_VIEWER_SELF;
+
+    return target->isGameMaster() ? UPDATE_VIEWER_GM : UPDATE_VIEWER_OTHER;
+}
+
 void Object::BuildOutOfRangeUpdateBlock(UpdateData* data) const
 {
     data->AddOutOfRangeGUID(GetObjectGuid());
@@ -757,6 +841,8 @@ void Object::ClearUpdateMask(bool remove)
             RemoveFromClientUpdateList();
         m_objectUpdated = false;
     }
+
+    InvalidateValuesUpdateCache();
 }
 
 bool Object::LoadValues(const char* data)
@@ -1039,18 +1125,9 @@ bool Object::PrintEntryError(char const* descr) const
     return false;
 }
 
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players)
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataBatch& update_players)
 {
-    UpdateDataMapType::iterator iter = update_players.find(pl);
-
-    if (iter == update_players.end())
-    {
-        std::pair<UpdateDataMapType::iterator, bool> p = update_players.insert(UpdateDataMapType::value_type(pl, UpdateData(pl->GetMapId())));
-        MANGOS_ASSERT(p.second);
-        iter = p.first;
-    }
-
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    BuildValuesUpdateBlockForPlayer(&update_players.GetUpdateData(pl), pl);
 }
 
 void Object::AddToClientUpdateList()
@@ -1065,7 +1142,7 @@ void Object::RemoveFromClientUpdateList()
     MANGOS_ASSERT(false);
 }
 
-void Object::BuildUpdateData(UpdateDataMapType& /*update_players */)
+void Object::BuildUpdateData(UpdateDataBatch& /*update_players */)
 {
     sLog.outError("Unexpected call of Object::BuildUpdateData for object (TypeId: %u Update fields: %u)", GetTypeId(), m_valuesCount);
     MANGOS_ASSERT(false);
@@ -1073,6 +1150,8 @@ void Object::BuildUpdateData(UpdateDataMapType& /*update_players */)
 
 void Object::MarkForClientUpdate()
 {
+    InvalidateValuesUpdateCache();
+
     if (m_inWorld)
     {
         if (!m_objectUpdated)
@@ -1086,6 +1165,7 @@ void Object::MarkForClientUpdate()
 WorldObject::WorldObject() :
     m_transportInfo(NULL), m_currMap(NULL),
     m_mapId(0), m_InstanceId(0), m_phaseMask(PHASEMASK_NORMAL),
+    m_positionIndexCell(MapPositionIndex::NOT_INDEXED), m_positionIndexSlot(0),
     m_isActiveObject(false)
 {
 }
@@ -1110,6 +1190,9 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
 
     if (isType(TYPEMASK_UNIT))
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, orientation);
+
+    if (m_positionIndexCell != MapPositionIndex::NOT_INDEXED)
+        GetMap()->GetPositionIndex().Relocate(this);
 }
 
 void WorldObject::Relocate(float x, float y, float z)
@@ -1120,6 +1203,9 @@ void WorldObject::Relocate(float x, float y, float z)
 
     if (isType(TYPEMASK_UNIT))
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, GetOrientation());
+
+    if (m_positionIndexCell != MapPositionIndex::NOT_INDEXED)
+        GetMap()->GetPositionIndex().Relocate(this);
 }
 
 void WorldObject::SetOrientation(float orientation)
@@ -1997,9 +2083,9 @@ void WorldObject::RemoveFromClientUpdateList()
 
 struct WorldObjectChangeAccumulator
 {
-    UpdateDataMapType& i_updateDatas;
+    UpdateDataBatch& i_updateDatas;
     WorldObject& i_object;
-    WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d) : i_updateDatas(d), i_object(obj)
+    WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataBatch& d) : i_updateDatas(d), i_object(obj)
     {
         // send self fields changes in another way, otherwise
         // with new camera system when player's camera too far from player, camera wouldn't receive packets and changes from player
@@ -2020,7 +2106,7 @@ struct WorldObjectChangeAccumulator
     template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
 };
 
-void WorldObject::BuildUpdateData(UpdateDataMapType& update_players)
+void WorldObject::BuildUpdateData(UpdateDataBatch& update_players)
 {
     WorldObjectChangeAccumulator notifier(*this, update_players);
     Cell::VisitWorldObjects(this, notifier, GetMap()->GetVisibilityDistance());
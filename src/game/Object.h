@@ -77,8 +77,6 @@ class TerrainInfo;
 class TransportInfo;
 struct MangosStringLocale;
 
-typedef UNORDERED_MAP<Player*, UpdateData> UpdateDataMapType;
-
 struct Position
 {
     Position() : x(0.0f), y(0.0f), z(0.0f), o(0.0f) {}
@@ -99,6 +97,16 @@ struct WorldLocation
         : mapid(loc.mapid), coord_x(loc.coord_x), coord_y(loc.coord_y), coord_z(loc.coord_z), orientation(NormalizeOrientation(loc.orientation)) {}
 };
 
+/// Observers of an object that receive the same values update block
+enum UpdateViewerClass
+{
+    UPDATE_VIEWER_SELF              = 0,                    // the player object itself
+    UPDATE_VIEWER_GM                = 1,
+    UPDATE_VIEWER_OTHER             = 2,
+};
+
+#define MAX_UPDATE_VIEWER_CLASS       3
+
 // use this class to measure time between world update ticks
 // essential for units updating their spells after cells become active
 class WorldUpdateCounter
@@ -122,6 +130,8 @@ class WorldUpdateCounter
 
 class MANGOS_DLL_SPEC Object
 {
+        friend class Map;                                   // client update queue slot
+
     public:
         virtual ~Object();
 
@@ -159,6 +169,7 @@ class MANGOS_DLL_SPEC Object
         void SetObjectScale(float newScale);
 
         uint8 GetTypeId() const { return m_objectTypeId; }
+        uint16 GetTypeMask() const { return m_objectType; }
         bool isType(TypeMask mask) const { return (mask & m_objectType); }
 
         virtual void BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) const;
@@ -167,11 +178,14 @@ class MANGOS_DLL_SPEC Object
         // must be overwrite in appropriate subclasses (WorldObject, Item currently), or will crash
         virtual void AddToClientUpdateList();
         virtual void RemoveFromClientUpdateList();
-        virtual void BuildUpdateData(UpdateDataMapType& update_players);
+        virtual void BuildUpdateData(UpdateDataBatch& update_players);
         void MarkForClientUpdate();
         void SendForcedObjectUpdate();
 
         void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+        // values blocks of a flush with every set field changed, shared per viewer class or built for every viewer,
+        // pending field changes are kept (.debug valuesbench); returns true if the blocks were shared
+        bool BuildFullValuesUpdateBlocks(std::vector<Player*> const& viewers, bool shared, UpdateDataBatch& update_players);
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
 
         virtual void DestroyForPlayer(Player* target, bool anim = false) const;
@@ -372,7 +386,7 @@ class MANGOS_DLL_SPEC Object
 
         void BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const;
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
-        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players);
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataBatch& update_players);
 
         uint16 m_objectType;
 
@@ -391,8 +405,34 @@ class MANGOS_DLL_SPEC Object
         uint16 m_valuesCount;
 
         bool m_objectUpdated;
+        uint32 m_clientUpdateSlot;                          // index in the client update queue of the map, valid while m_objectUpdated
 
     private:
+        // values update blocks (without type and guid) built for current field changes, one per viewer class
+        struct ValuesUpdateCache
+        {
+            ValuesUpdateCache()
+            {
+                for (int i = 0; i < MAX_UPDATE_VIEWER_CLASS; ++i)
+                    m_version[i] = 0;
+            }
+
+            ByteBuffer m_block[MAX_UPDATE_VIEWER_CLASS];
+            uint32 m_version[MAX_UPDATE_VIEWER_CLASS];      // m_valuesUpdateVersion at block build
+        };
+
+        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, bool useCache) const;
+        bool CanCacheValuesUpdate() const;
+        UpdateViewerClass GetUpdateViewerClass(Player const* target) const;
+        void InvalidateValuesUpdateCache()
+        {
+            if (++m_valuesUpdateVersion == 0)               // 0 is reserved for not built blocks
+                m_valuesUpdateVersion = 1;
+        }
+
+        mutable ValuesUpdateCache* m_valuesUpdateCache;     // created at first cacheable values update
+        uint32 m_valuesUpdateVersion;                       // changed at any field change and at ClearUpdateMask
+
         bool m_inWorld;
 
         PackedGuid m_PackGUID;
@@ -411,6 +451,7 @@ struct WorldObjectChangeAccumulator;
 class MANGOS_DLL_SPEC WorldObject : public Object
 {
         friend struct WorldObjectChangeAccumulator;
+        friend class MapPositionIndex;                      // position index cell and slot
 
     public:
 
@@ -601,7 +642,7 @@ class MANGOS_DLL_SPEC WorldObject : public Object
 
         void AddToClientUpdateList() override;
         void RemoveFromClientUpdateList() override;
-        void BuildUpdateData(UpdateDataMapType&) override;
+        void BuildUpdateData(UpdateDataBatch&) override;
 
         Creature* SummonCreature(uint32 id, float x, float y, float z, float ang, TempSummonType spwtype, uint32 despwtime, bool asActiveObject = false);
 
@@ -638,6 +679,8 @@ class MANGOS_DLL_SPEC WorldObject : public Object
         uint32 m_phaseMask;                                 // in area phase state
 
         Position m_position;
+        uint32 m_positionIndexCell;                         // cell key in map position index, MapPositionIndex::NOT_INDEXED if not indexed
+        uint32 m_positionIndexSlot;
         ViewPoint m_viewPoint;
         WorldUpdateCounter m_updateTracker;
         bool m_isActiveObject;
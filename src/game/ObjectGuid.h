@@ -315,13 +315,14 @@ class ObjectGuidGenerator
         explicit ObjectGuidGenerator(uint32 start = 1) : m_nextGuid(start) {}
 
     public:                                                 // modifiers
-        void Set(uint32 val) { m_nextGuid = val; }
+        void Set(uint32 val) { ACE_Guard<ACE_Thread_Mutex> guard(m_lock); m_nextGuid = val; }
         uint32 Generate();
 
     public:                                                 // accessors
         uint32 GetNextAfterMaxUsed() const { return m_nextGuid; }
 
     private:                                                // fields
+        ACE_Thread_Mutex m_lock;                            // global generators are used from map update threads
         uint32 m_nextGuid;
 };
 
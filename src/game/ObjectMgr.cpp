@@ -137,6 +137,8 @@ bool SpellClickInfo::IsFitToRequirements(Player const* player, Creature const* c
 template<typename T>
 T IdGenerator<T>::Generate()
 {
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
     if (m_nextGuid >= std::numeric_limits<T>::max() - 1)
     {
         sLog.outError("%s guid overflow!! Can't continue, shutting down server. ", m_name);
@@ -1301,8 +1303,8 @@ void ObjectMgr::LoadCreatureModelRace()
 void ObjectMgr::LoadCreatures()
 {
     uint32 count = 0;
-    //                                                0                       1   2    3
-    QueryResult* result = WorldDatabase.Query("SELECT creature.guid, creature.id, map, modelid,"
+    //                                                      0                       1   2    3
+    QueryResult* result = WorldDatabase.StreamQuery("SELECT creature.guid, creature.id, map, modelid,"
                           //   4             5           6           7           8            9              10         11
                           "equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, spawndist, currentwaypoint,"
                           //   12         13       14          15            16         17         18
@@ -1480,6 +1482,14 @@ void ObjectMgr::LoadCreatures()
     }
     while (result->NextRow());
 
+    // spawns already added to grids and pools can't be taken back, a partial table is fatal
+    if (result->IsIncomplete())
+    {
+        sLog.outErrorDb("Table `creature` could not be read completely, only %u rows were loaded!", count);
+        Log::WaitBeforeContinueIfNeed();
+        exit(1);
+    }
+
     delete result;
 
     sLog.outString(">> Loaded " SIZEFMTD " creatures", mCreatureDataMap.size());
@@ -1522,8 +1532,8 @@ void ObjectMgr::LoadGameObjects()
 {
     uint32 count = 0;
 
-    //                                                0                           1   2    3           4           5           6
-    QueryResult* result = WorldDatabase.Query("SELECT gameobject.guid, gameobject.id, map, position_x, position_y, position_z, orientation,"
+    //                                                      0                           1   2    3           4           5           6
+    QueryResult* result = WorldDatabase.StreamQuery("SELECT gameobject.guid, gameobject.id, map, position_x, position_y, position_z, orientation,"
                           //   7          8          9          10         11             12            13     14         15         16
                           "rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, spawnMask, phaseMask, event,"
                           //   17                          18
@@ -1678,6 +1688,14 @@ void ObjectMgr::LoadGameObjects()
     }
     while (result->NextRow());
 
+    // spawns already added to grids and pools can't be taken back, a partial table is fatal
+    if (result->IsIncomplete())
+    {
+        sLog.outErrorDb("Table `gameobject` could not be read completely, only %u rows were loaded!", count);
+        Log::WaitBeforeContinueIfNeed();
+        exit(1);
+    }
+
     delete result;
 
     sLog.outString(">> Loaded " SIZEFMTD " gameobjects", mGameObjectDataMap.size());
@@ -7211,6 +7229,9 @@ void ObjectMgr::LoadSpellTemplate()
         else
             sSpellStore.InsertEntry(const_cast<SpellEntry*>(spellEntry), i);
     }
+
+    // serverside spells replace or add entries, their SpellInfo has to follow
+    LoadSpellInfoStore();
 }
 
 void ObjectMgr::LoadWeatherZoneChances()
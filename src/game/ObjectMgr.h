@@ -509,7 +509,7 @@ class IdGenerator
         explicit IdGenerator(char const* _name) : m_name(_name), m_nextGuid(1) {}
 
     public:                                                 // modifiers
-        void Set(T val) { m_nextGuid = val; }
+        void Set(T val) { ACE_Guard<ACE_Thread_Mutex> guard(m_lock); m_nextGuid = val; }
         T Generate();
 
     public:                                                 // accessors
@@ -517,6 +517,7 @@ class IdGenerator
 
     private:                                                // fields
         char const* m_name;
+        ACE_Thread_Mutex m_lock;                            // ids are generated from map update threads too
         T m_nextGuid;
 };
 
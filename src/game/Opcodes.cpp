@@ -1837,6 +1837,7 @@ void InitializeOpcodes()
     OPCODE(SMSG_EMOTE,                                                      0x2000, STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(SMSG_TRIGGER_CINEMATIC,                                          0x2000, STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(SMSG_UPDATE_OBJECT,                                              0x2000, STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
+    OPCODE(SMSG_COMPRESSED_UPDATE_OBJECT,                                   0x2000, STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(SMSG_UNDELETE_CHARACTER_RESPONSE,                                0x2000, STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(SMSG_UNDELETE_COOLDOWN_STATUS_RESPONSE,                          0x2000, STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     OPCODE(SMSG_TREASURE_DEBUG,                                             0x2000, STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -1811,6 +1811,7 @@ enum Opcodes
     SMSG_EMOTE,
     SMSG_TRIGGER_CINEMATIC,
     SMSG_UPDATE_OBJECT,
+    SMSG_COMPRESSED_UPDATE_OBJECT,
     SMSG_UNDELETE_CHARACTER_RESPONSE,
     SMSG_UNDELETE_COOLDOWN_STATUS_RESPONSE,
     SMSG_TREASURE_DEBUG,
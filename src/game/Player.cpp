@@ -375,6 +375,9 @@ Player::Player(WorldSession* session): Unit(), m_mover(this), m_camera(this), m_
 {
     m_transport = 0;
 
+    m_updateBatch = NULL;
+    m_updateBatchSlot = 0;
+
     m_speakTime = 0;
     m_speakCount = 0;
 
@@ -498,6 +501,7 @@ Player::Player(WorldSession* session): Unit(), m_mover(this), m_camera(this), m_
     //////////////////// Rest System/////////////////////
 
     m_mailsUpdated = false;
+    m_spellCooldownsChanged = false;
     unReadMails = 0;
     m_nextMailDelivereTime = 0;
 
@@ -1203,6 +1207,10 @@ void Player::Update(uint32 update_diff, uint32 p_time)
     Unit::Update(update_diff, p_time);
     SetCanDelayTeleport(false);
 
+    // drop the holes of spell mods removed since last update, nothing iterates them here
+    for (int i = 0; i < MAX_SPELLMOD; ++i)
+        m_spellMods[i].Compact();
+
     // Update player only attacks
     if (uint32 ranged_att = getAttackTimer(RANGED_ATTACK))
         setAttackTimer(RANGED_ATTACK, (update_diff >= ranged_att ? 0 : ranged_att - update_diff));
@@ -3678,7 +3686,8 @@ void Player::removeSpell(uint32 spell_id, bool disabled, bool learn_low_rank, bo
 
 void Player::RemoveSpellCooldown(uint32 spell_id, bool update /* = false */)
 {
-    m_spellCooldowns.erase(spell_id);
+    if (m_spellCooldowns.erase(spell_id))
+        m_spellCooldownsChanged = true;
 
     if (update)
         SendClearCooldown(spell_id, this);
@@ -3742,6 +3751,7 @@ void Player::RemoveAllSpellCooldown()
         SendDirectMessage(&data);
 
         m_spellCooldowns.clear();
+        m_spellCooldownsChanged = true;
     }
 }
 
@@ -3773,7 +3783,11 @@ void Player::_LoadSpellCooldowns(QueryResult* result)
             if (db_time <= curTime)
                 continue;
 
-            AddSpellCooldown(spell_id, item_id, db_time);
+            // not AddSpellCooldown, cooldowns just loaded don't need a save
+            SpellCooldown sc;
+            sc.end = db_time;
+            sc.itemid = item_id;
+            m_spellCooldowns[spell_id] = sc;
 
             DEBUG_LOG("Player (GUID: %u) spell %u, item %u cooldown loaded (%u secs).", GetGUIDLow(), spell_id, item_id, uint32(db_time - curTime));
         }
@@ -3785,6 +3799,10 @@ void Player::_LoadSpellCooldowns(QueryResult* result)
 
 void Player::_SaveSpellCooldowns()
 {
+    // expired cooldowns left in the db are skipped at load, so only added or removed ones need a save
+    if (!m_spellCooldownsChanged)
+        return;
+
     static SqlStatementID deleteSpellCooldown ;
     static SqlStatementID insertSpellCooldown ;
 
@@ -3808,6 +3826,8 @@ void Player::_SaveSpellCooldowns()
         else
             ++itr;
     }
+
+    m_spellCooldownsChanged = false;
 }
 
 uint32 Player::resetTalentsCost() const
@@ -16618,8 +16638,12 @@ void Player::UnbindInstance(BoundInstancesMap::iterator& itr, Difficulty difficu
     if (itr != m_boundInstances[difficulty].end())
     {
         if (!unload)
-            CharacterDatabase.PExecute("DELETE FROM character_instance WHERE guid = '%u' AND instance = '%u'",
-                                       GetGUIDLow(), itr->second.state->GetInstanceId());
+        {
+            static SqlStatementID delInstanceBind ;
+
+            SqlStatement stmt = CharacterDatabase.CreateStatement(delInstanceBind, "DELETE FROM character_instance WHERE guid = ? AND instance = ?");
+            stmt.PExecute(GetGUIDLow(), itr->second.state->GetInstanceId());
+        }
 
         sCalendarMgr.SendCalendarRaidLockoutRemove(this, itr->second.state);
 
@@ -16632,20 +16656,29 @@ InstancePlayerBind* Player::BindToInstance(DungeonPersistentState* state, bool p
 {
     if (state)
     {
+        static SqlStatementID updInstanceBind ;
+        static SqlStatementID insInstanceBind ;
+
         InstancePlayerBind& bind = m_boundInstances[state->GetDifficulty()][state->GetMapId()];
         if (bind.state)
         {
             // update the state when the group kills a boss
             if (permanent != bind.perm || state != bind.state)
+            {
                 if (!load)
-                    CharacterDatabase.PExecute("UPDATE character_instance SET instance = '%u', permanent = '%u' WHERE guid = '%u' AND instance = '%u'",
-                                               state->GetInstanceId(), permanent, GetGUIDLow(), bind.state->GetInstanceId());
+                {
+                    SqlStatement stmt = CharacterDatabase.CreateStatement(updInstanceBind, "UPDATE character_instance SET instance = ?, permanent = ? WHERE guid = ? AND instance = ?");
+                    stmt.PExecute(state->GetInstanceId(), uint32(permanent), GetGUIDLow(), bind.state->GetInstanceId());
+                }
+            }
         }
         else
         {
             if (!load)
-                CharacterDatabase.PExecute("INSERT INTO character_instance (guid, instance, permanent) VALUES ('%u', '%u', '%u')",
-                                           GetGUIDLow(), state->GetInstanceId(), permanent);
+            {
+                SqlStatement stmt = CharacterDatabase.CreateStatement(insInstanceBind, "INSERT INTO character_instance (guid, instance, permanent) VALUES (?, ?, ?)");
+                stmt.PExecute(GetGUIDLow(), state->GetInstanceId(), uint32(permanent));
+            }
         }
 
         if (bind.state != state)
@@ -16893,7 +16926,8 @@ void Player::SaveToDB()
     DEBUG_FILTER_LOG(LOG_FILTER_PLAYER_STATS, "The value of player %s at save: ", m_name.c_str());
     outDebugStatsValues();
 
-    CharacterDatabase.BeginTransaction();
+    // keep all saves of this character on one async worker, they only need to stay ordered among themselves
+    CharacterDatabase.BeginTransaction(GetGUIDLow());
 
     static SqlStatementID delChar ;
     static SqlStatementID insChar ;
@@ -19359,6 +19393,7 @@ void Player::AddSpellCooldown(uint32 spellid, uint32 itemid, time_t end_time)
     sc.end = end_time;
     sc.itemid = itemid;
     m_spellCooldowns[spellid] = sc;
+    m_spellCooldownsChanged = true;
 }
 
 void Player::SendCooldownEvent(SpellEntry const* spellInfo, uint32 itemId, Spell* spell)
@@ -22916,8 +22951,16 @@ void Player::SetHomebindToLocation(WorldLocation const& loc, uint32 area_id)
     m_homebindZ = loc.coord_z;
 
     // update sql homebind
-    CharacterDatabase.PExecute("UPDATE character_homebind SET map = '%u', zone = '%u', position_x = '%f', position_y = '%f', position_z = '%f' WHERE guid = '%u'",
-                               m_homebindMapId, m_homebindAreaId, m_homebindX, m_homebindY, m_homebindZ, GetGUIDLow());
+    static SqlStatementID updHomebind ;
+
+    SqlStatement stmt = CharacterDatabase.CreateStatement(updHomebind, "UPDATE character_homebind SET map = ?, zone = ?, position_x = ?, position_y = ?, position_z = ? WHERE guid = ?");
+    stmt.addUInt32(m_homebindMapId);
+    stmt.addUInt32(m_homebindAreaId);
+    stmt.addFloat(m_homebindX);
+    stmt.addFloat(m_homebindY);
+    stmt.addFloat(m_homebindZ);
+    stmt.addUInt32(GetGUIDLow());
+    stmt.Execute();
 }
 
 Object* Player::GetObjectByTypeMask(ObjectGuid guid, TypeMask typemask)
@@ -23433,12 +23476,33 @@ void Player::_LoadCurrencies(QueryResult* result)
 
 void Player::_SaveCurrencies()
 {
+    static SqlStatementID updCurrency ;
+    static SqlStatementID insCurrency ;
+
     for (PlayerCurrenciesMap::iterator itr = m_currencies.begin(); itr != m_currencies.end();)
     {
         if (itr->second.state == PLAYERCURRENCY_CHANGED)
-            CharacterDatabase.PExecute("UPDATE `character_currencies` SET `totalCount` = '%u', `weekCount` = '%u', `seasonCount` = '%u', `flags` = '%u' WHERE `guid` = '%u' AND `id` = '%u'", itr->second.totalCount, itr->second.weekCount, itr->second.seasonCount, itr->second.flags, GetGUIDLow(), itr->first);
+        {
+            SqlStatement stmt = CharacterDatabase.CreateStatement(updCurrency, "UPDATE `character_currencies` SET `totalCount` = ?, `weekCount` = ?, `seasonCount` = ?, `flags` = ? WHERE `guid` = ? AND `id` = ?");
+            stmt.addUInt32(itr->second.totalCount);
+            stmt.addUInt32(itr->second.weekCount);
+            stmt.addUInt32(itr->second.seasonCount);
+            stmt.addUInt8(itr->second.flags);
+            stmt.addUInt32(GetGUIDLow());
+            stmt.addUInt32(itr->first);
+            stmt.Execute();
+        }
         else if (itr->second.state == PLAYERCURRENCY_NEW)
-            CharacterDatabase.PExecute("INSERT INTO `character_currencies` (`guid`, `id`, `totalCount`, `weekCount`, `seasonCount`, `flags`) VALUES ('%u', '%u', '%u', '%u', '%u', '%u')", GetGUIDLow(), itr->first, itr->second.totalCount, itr->second.weekCount, itr->second.seasonCount, itr->second.flags);
+        {
+            SqlStatement stmt = CharacterDatabase.CreateStatement(insCurrency, "INSERT INTO `character_currencies` (`guid`, `id`, `totalCount`, `weekCount`, `seasonCount`, `flags`) VALUES (?, ?, ?, ?, ?, ?)");
+            stmt.addUInt32(GetGUIDLow());
+            stmt.addUInt32(itr->first);
+            stmt.addUInt32(itr->second.totalCount);
+            stmt.addUInt32(itr->second.weekCount);
+            stmt.addUInt32(itr->second.seasonCount);
+            stmt.addUInt8(itr->second.flags);
+            stmt.Execute();
+        }
 
         if (itr->second.state == PLAYERCURRENCY_REMOVED)
             m_currencies.erase(itr++);
@@ -1004,6 +1004,7 @@ class MANGOS_DLL_SPEC Player : public Unit
         friend class WorldSession;
         friend void Item::AddToUpdateQueueOf(Player* player);
         friend void Item::RemoveFromUpdateQueueOf(Player* player);
+        friend class UpdateDataBatch;
     public:
         explicit Player(WorldSession* session);
         ~Player();
@@ -2490,6 +2491,7 @@ class MANGOS_DLL_SPEC Player : public Unit
         PlayerTalentMap m_talents[MAX_TALENT_SPEC_COUNT];
         uint32 m_talentsPrimaryTree[MAX_TALENT_SPEC_COUNT];
         SpellCooldowns m_spellCooldowns;
+        bool m_spellCooldownsChanged;                       // cooldowns added or removed since last save, expired ones not counted
         uint32 m_lastPotionId;                              // last used health/mana potion in combat, that block next potion use
 
         GlobalCooldownMgr m_GlobalCooldownMgr;
@@ -2675,6 +2677,10 @@ class MANGOS_DLL_SPEC Player : public Unit
         uint32 m_timeSyncServer;
 
         uint32 m_cachedGS;
+
+        // last UpdateDataBatch this player was added to and its slot there
+        UpdateDataBatch const* m_updateBatch;
+        uint32 m_updateBatchSlot;
 };
 
 void AddItemsSetItem(Player* player, Item* item);
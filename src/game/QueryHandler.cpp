@@ -62,7 +62,7 @@ void WorldSession::SendNameQueryOpcode(Player* p)
 
 void WorldSession::SendNameQueryOpcodeFromDB(ObjectGuid guid)
 {
-    CharacterDatabase.AsyncPQuery(&WorldSession::SendNameQueryOpcodeFromDBCallBack, GetAccountId(),
+    CharacterDatabase.AsyncPQuery(GetQueryResultQueue(), this, &WorldSession::SendNameQueryOpcodeFromDBCallBack,
                                   !sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED) ?
                                   //   ------- Query Without Declined Names --------
                                   //          0     1     2     3       4
@@ -78,24 +78,17 @@ void WorldSession::SendNameQueryOpcodeFromDB(ObjectGuid guid)
                                   guid.GetCounter());
 }
 
-void WorldSession::SendNameQueryOpcodeFromDBCallBack(QueryResult* result, uint32 accountId)
+void WorldSession::SendNameQueryOpcodeFromDBCallBack(QueryResult* result)
 {
     if (!result)
         return;
 
-    WorldSession* session = sWorld.FindSession(accountId);
-    if (!session)
-    {
-        delete result;
-        return;
-    }
-
     Field* fields = result->Fetch();
     uint32 lowguid      = fields[0].GetUInt32();
     std::string name = fields[1].GetCppString();
     uint8 pRace = 0, pGender = 0, pClass = 0;
     if (name == "")
-        name         = session->GetMangosString(LANG_NON_EXIST_CHARACTER);
+        name         = GetMangosString(LANG_NON_EXIST_CHARACTER);
     else
     {
         pRace        = fields[2].GetUInt8();
@@ -122,7 +115,7 @@ void WorldSession::SendNameQueryOpcodeFromDBCallBack(QueryResult* result, uint32
     else
         data << uint8(0);                                   // is not declined
 
-    session->SendPacket(&data);
+    SendPacket(&data);
     delete result;
 }
 
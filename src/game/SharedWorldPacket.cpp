@@ -0,0 +1,78 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SharedWorldPacket.h"
+#include "WorldPacket.h"
+
+#include <ace/Message_Block.h>
+#include <ace/Lock_Adapter_T.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Malloc_Base.h>
+
+#include <new>
+
+// payload duplicates are released by the network threads, so the reference count needs a lock,
+// every payload has its own one to not serialize the sockets over all broadcasts
+class SharedPayloadBlock : public ACE_Data_Block
+{
+    public:
+        // the base only keeps the pointer, m_lock is constructed right after it
+        explicit SharedPayloadBlock(size_t size) :
+            ACE_Data_Block(size, ACE_Message_Block::MB_DATA, NULL, NULL, &m_lock, 0, NULL) {}
+
+        // ACE frees data blocks through their allocator, after the lock was released
+        static ACE_Data_Block* Create(size_t size)
+        {
+            void* mem = ACE_Allocator::instance()->malloc(sizeof(SharedPayloadBlock));
+            return new (mem) SharedPayloadBlock(size);
+        }
+
+    private:
+        ACE_Lock_Adapter<ACE_Thread_Mutex> m_lock;
+};
+
+SharedWorldPacket::SharedWorldPacket(WorldPacket& packet) : m_packet(packet), m_payload(NULL)
+{
+    // the body must be final before it gets shared
+    packet.FlushBits();
+}
+
+SharedWorldPacket::SharedWorldPacket(SharedWorldPacket const& other) :
+    m_packet(other.m_packet), m_payload(other.m_payload ? other.m_payload->duplicate() : NULL)
+{
+}
+
+SharedWorldPacket::~SharedWorldPacket()
+{
+    if (m_payload)
+        m_payload->release();
+}
+
+ACE_Message_Block* SharedWorldPacket::GetPayload() const
+{
+    if (!m_payload)
+    {
+        m_payload = new ACE_Message_Block(SharedPayloadBlock::Create(m_packet.size()));
+
+        // fills the block completely, so no socket will ever append to it
+        if (!m_packet.empty())
+            m_payload->copy((char const*)m_packet.contents(), m_packet.size());
+    }
+
+    return m_payload;
+}
@@ -0,0 +1,54 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SHAREDWORLDPACKET_H
+#define MANGOS_SHAREDWORLDPACKET_H
+
+#include "Common.h"
+
+class WorldPacket;
+class ACE_Message_Block;
+
+/**
+ * Packet sent unchanged to many sessions, used by the SendMessageToSet deliverers.
+ *
+ * The packet body is copied once into a reference counted message block, every
+ * socket queues its own duplicate() of it after the per socket encrypted header
+ * instead of copying the body into its output buffer. The block is created on
+ * first use, so one SharedWorldPacket must only be used from a single thread.
+ */
+class SharedWorldPacket
+{
+    public:
+        explicit SharedWorldPacket(WorldPacket& packet);
+        SharedWorldPacket(SharedWorldPacket const& other);
+        ~SharedWorldPacket();
+
+        WorldPacket const& GetPacket() const { return m_packet; }
+
+        // body of the packet, the caller has to duplicate() it to keep a reference
+        ACE_Message_Block* GetPayload() const;
+
+    private:
+        SharedWorldPacket& operator=(SharedWorldPacket const&);
+
+        WorldPacket const& m_packet;
+        mutable ACE_Message_Block* m_payload;
+};
+
+#endif
@@ -599,6 +599,7 @@ class Spell
         void SetTargetMap(SpellEffectIndex effIndex, uint32 targetMode, UnitList& targetUnitMap);
 
         void FillAreaTargets(UnitList& targetUnitMap, float radius, SpellNotifyPushType pushType, SpellTargets spellTargets, WorldObject* originalCaster = NULL);
+        void LimitTargetsRandomly(UnitList& targetUnitMap, uint32 maxTargets);
         void FillRaidOrPartyTargets(UnitList& targetUnitMap, Unit* member, Unit* center, float radius, bool raid, bool withPets, bool withcaster);
         void FillRaidOrPartyManaPriorityTargets(UnitList& targetUnitMap, Unit* member, Unit* center, float radius, uint32 count, bool raid, bool withPets, bool withcaster);
         void FillRaidOrPartyHealthPriorityTargets(UnitList& targetUnitMap, Unit* member, Unit* center, float radius, uint32 count, bool raid, bool withPets, bool withcaster);
@@ -759,22 +760,43 @@ namespace MaNGOS
         SpellTargets i_TargetType;
         WorldObject* i_originalCaster;
         WorldObject* i_castingObject;
+        WorldObject const* i_centerObject;                  // object the range is measured from, NULL for PUSH_DEST_CENTER
         bool i_playerControlled;
+        bool i_hasCenter;
         float i_centerX;
         float i_centerY;
         float i_centerZ;
 
         float GetCenterX() const { return i_centerX; }
         float GetCenterY() const { return i_centerY; }
+        bool HasCenter() const { return i_hasCenter; }
+        // radius around the center that contains all possible targets
+        float GetSearchRadius() const { return i_centerObject ? i_radius + i_centerObject->GetObjectBoundingRadius() : i_radius; }
 
         SpellNotifierCreatureAndPlayer(Spell& spell, Spell::UnitList& data, float radius, SpellNotifyPushType type,
                                        SpellTargets TargetType = SPELL_TARGETS_NOT_FRIENDLY, WorldObject* originalCaster = NULL)
             : i_data(&data), i_spell(spell), i_push_type(type), i_radius(radius), i_TargetType(TargetType),
               i_originalCaster(originalCaster), i_castingObject(i_spell.GetCastingObject())
+        {
+            Initialize();
+        }
+
+        // check only notifier, see IsTarget
+        SpellNotifierCreatureAndPlayer(Spell& spell, float radius, SpellNotifyPushType type,
+                                       SpellTargets TargetType = SPELL_TARGETS_NOT_FRIENDLY, WorldObject* originalCaster = NULL)
+            : i_data(NULL), i_spell(spell), i_push_type(type), i_radius(radius), i_TargetType(TargetType),
+              i_originalCaster(originalCaster), i_castingObject(i_spell.GetCastingObject())
+        {
+            Initialize();
+        }
+
+        void Initialize()
         {
             if (!i_originalCaster)
                 i_originalCaster = i_spell.GetAffectiveCasterObject();
             i_playerControlled = i_originalCaster  ? i_originalCaster->IsControlledByPlayer() : false;
+            i_centerObject = NULL;
+            i_hasCenter = false;
 
             switch (i_push_type)
             {
@@ -788,6 +810,8 @@ namespace MaNGOS
                     {
                         i_centerX = i_castingObject->GetPositionX();
                         i_centerY = i_castingObject->GetPositionY();
+                        i_centerObject = i_castingObject;
+                        i_hasCenter = true;
                     }
                     break;
                 case PUSH_DEST_CENTER:
@@ -795,12 +819,15 @@ namespace MaNGOS
                         i_spell.m_targets.getSource(i_centerX, i_centerY, i_centerZ);
                     else
                         i_spell.m_targets.getDestination(i_centerX, i_centerY, i_centerZ);
+                    i_hasCenter = true;
                     break;
                 case PUSH_TARGET_CENTER:
                     if (Unit* target = i_spell.m_targets.getUnitTarget())
                     {
                         i_centerX = target->GetPositionX();
                         i_centerY = target->GetPositionY();
+                        i_centerObject = target;
+                        i_hasCenter = true;
                     }
                     break;
                 default:
@@ -808,99 +835,93 @@ namespace MaNGOS
             }
         }
 
-        template<class T> inline void Visit(GridRefManager<T>&  m)
+        // target type and area shape checks for a single unit
+        bool IsTarget(Unit* target) const
         {
-            MANGOS_ASSERT(i_data);
-
             if (!i_originalCaster || !i_castingObject)
-                return;
+                return false;
 
-            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
-            {
-                // there are still more spells which can be casted on dead, but
-                // they are no AOE and don't have such a nice SPELL_ATTR flag
-                if ((i_TargetType != SPELL_TARGETS_ALL && !itr->getSource()->isTargetableForAttack(i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX3_CAST_ON_DEAD)))
-                        // mostly phase check
-                        || !itr->getSource()->IsInMap(i_originalCaster))
-                    continue;
+            // there are still more spells which can be casted on dead, but
+            // they are no AOE and don't have such a nice SPELL_ATTR flag
+            if ((i_TargetType != SPELL_TARGETS_ALL && !target->isTargetableForAttack(i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX3_CAST_ON_DEAD)))
+                    // mostly phase check
+                    || !target->IsInMap(i_originalCaster))
+                return false;
 
-                switch (i_TargetType)
+            switch (i_TargetType)
+            {
+                case SPELL_TARGETS_HOSTILE:
+                    if (!i_originalCaster->IsHostileTo(target))
+                        return false;
+                    break;
+                case SPELL_TARGETS_NOT_FRIENDLY:
+                    if (i_originalCaster->IsFriendlyTo(target))
+                        return false;
+                    break;
+                case SPELL_TARGETS_NOT_HOSTILE:
+                    if (i_originalCaster->IsHostileTo(target))
+                        return false;
+                    break;
+                case SPELL_TARGETS_FRIENDLY:
+                    if (!i_originalCaster->IsFriendlyTo(target))
+                        return false;
+                    break;
+                case SPELL_TARGETS_AOE_DAMAGE:
                 {
-                    case SPELL_TARGETS_HOSTILE:
-                        if (!i_originalCaster->IsHostileTo(itr->getSource()))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_NOT_FRIENDLY:
-                        if (i_originalCaster->IsFriendlyTo(itr->getSource()))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_NOT_HOSTILE:
-                        if (i_originalCaster->IsHostileTo(itr->getSource()))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_FRIENDLY:
-                        if (!i_originalCaster->IsFriendlyTo(itr->getSource()))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_AOE_DAMAGE:
+                    if (target->GetTypeId() == TYPEID_UNIT && ((Creature*)target)->IsTotem())
+                        return false;
+
+                    if (i_playerControlled)
                     {
-                        if (itr->getSource()->GetTypeId() == TYPEID_UNIT && ((Creature*)itr->getSource())->IsTotem())
-                            continue;
-
-                        if (i_playerControlled)
-                        {
-                            if (i_originalCaster->IsFriendlyTo(itr->getSource()))
-                                continue;
-                        }
-                        else
-                        {
-                            if (!i_originalCaster->IsHostileTo(itr->getSource()))
-                                continue;
-                        }
+                        if (i_originalCaster->IsFriendlyTo(target))
+                            return false;
+                    }
+                    else
+                    {
+                        if (!i_originalCaster->IsHostileTo(target))
+                            return false;
                     }
-                    break;
-                    case SPELL_TARGETS_ALL:
-                        break;
-                    default: continue;
                 }
+                break;
+                case SPELL_TARGETS_ALL:
+                    break;
+                default: return false;
+            }
 
-                // we don't need to check InMap here, it's already done some lines above
-                switch (i_push_type)
-                {
-                    case PUSH_IN_FRONT:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, 2 * M_PI_F / 3))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_90:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F / 2))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_30:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F / 6))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_15:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F / 12))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_BACK:
-                        if (i_castingObject->isInBack((Unit*)(itr->getSource()), i_radius, 2 * M_PI_F / 3))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_SELF_CENTER:
-                        if (i_castingObject->IsWithinDist((Unit*)(itr->getSource()), i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_DEST_CENTER:
-                        if (itr->getSource()->IsWithinDist3d(i_centerX, i_centerY, i_centerZ, i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_TARGET_CENTER:
-                        if (i_spell.m_targets.getUnitTarget() && i_spell.m_targets.getUnitTarget()->IsWithinDist((Unit*)(itr->getSource()), i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                }
+            // we don't need to check InMap here, it's already done some lines above
+            switch (i_push_type)
+            {
+                case PUSH_IN_FRONT:
+                    return i_castingObject->isInFront(target, i_radius, 2 * M_PI_F / 3);
+                case PUSH_IN_FRONT_90:
+                    return i_castingObject->isInFront(target, i_radius, M_PI_F / 2);
+                case PUSH_IN_FRONT_30:
+                    return i_castingObject->isInFront(target, i_radius, M_PI_F / 6);
+                case PUSH_IN_FRONT_15:
+                    return i_castingObject->isInFront(target, i_radius, M_PI_F / 12);
+                case PUSH_IN_BACK:
+                    return i_castingObject->isInBack(target, i_radius, 2 * M_PI_F / 3);
+                case PUSH_SELF_CENTER:
+                    return i_castingObject->IsWithinDist(target, i_radius);
+                case PUSH_DEST_CENTER:
+                    return target->IsWithinDist3d(i_centerX, i_centerY, i_centerZ, i_radius);
+                case PUSH_TARGET_CENTER:
+                    return i_spell.m_targets.getUnitTarget() && i_spell.m_targets.getUnitTarget()->IsWithinDist(target, i_radius);
             }
+
+            return false;
+        }
+
+        template<class T> inline void Visit(GridRefManager<T>&  m)
+        {
+            MANGOS_ASSERT(i_data);
+
+            if (!i_originalCaster || !i_castingObject)
+                return;
+
+            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+                if (IsTarget(itr->getSource()))
+                    i_data->push_back(itr->getSource());
         }
 
 #ifdef WIN32
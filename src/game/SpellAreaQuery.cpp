@@ -0,0 +1,213 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SpellAreaQuery.h"
+#include "Map.h"
+#include "Unit.h"
+#include "Util.h"
+
+#include <algorithm>
+
+namespace
+{
+    struct DistanceOrderNear
+    {
+        explicit DistanceOrderNear(WorldObject const* origin) : m_origin(origin) {}
+
+        bool operator()(Unit const* a, Unit const* b) const { return m_origin->GetDistanceOrder(a, b); }
+
+        WorldObject const* m_origin;
+    };
+
+    struct DistanceOrderFar
+    {
+        explicit DistanceOrderFar(WorldObject const* origin) : m_origin(origin) {}
+
+        bool operator()(Unit const* a, Unit const* b) const { return m_origin->GetDistanceOrder(b, a); }
+
+        WorldObject const* m_origin;
+    };
+
+    struct WithinDistOf
+    {
+        WithinDistOf(WorldObject const* origin, float dist) : m_origin(origin), m_dist(dist) {}
+
+        bool operator()(Unit const* unit) const { return m_origin->IsWithinDist(unit, m_dist); }
+
+        WorldObject const* m_origin;
+        float m_dist;
+    };
+}
+
+SpellAreaQuery::SpellAreaQuery(Map& map) : m_map(map), m_buffer(&map.GetQueryBuffer())
+{
+    if (m_buffer->m_inUse)
+        m_buffer = &m_ownBuffer;
+
+    m_buffer->m_inUse = true;
+    m_buffer->m_candidates.clear();
+    m_buffer->m_units.clear();
+}
+
+SpellAreaQuery::~SpellAreaQuery()
+{
+    m_buffer->m_inUse = false;
+}
+
+void SpellAreaQuery::Query(float x, float y, float radius)
+{
+    m_buffer->m_candidates.clear();
+    m_map.GetPositionIndex().GetObjectsInRange(x, y, 0.0f, radius, TYPEMASK_UNIT, false, m_buffer->m_candidates);
+}
+
+void SpellAreaQuery::SelectSpellTargets(Spell& spell, float radius, SpellNotifyPushType pushType, SpellTargets spellTargets, WorldObject* originalCaster /*=NULL*/)
+{
+    MaNGOS::SpellNotifierCreatureAndPlayer notifier(spell, radius, pushType, spellTargets, originalCaster);
+    if (!notifier.HasCenter())
+        return;
+
+    // the 2D query is a superset of every shape, the notifier does the exact check
+    Query(notifier.GetCenterX(), notifier.GetCenterY(), notifier.GetSearchRadius());
+
+    for (std::vector<WorldObject*>::const_iterator itr = m_buffer->m_candidates.begin(); itr != m_buffer->m_candidates.end(); ++itr)
+        if (notifier.IsTarget((Unit*)*itr))
+            m_buffer->m_units.push_back((Unit*)*itr);
+}
+
+void SpellAreaQuery::Assign(std::list<Unit*> const& units)
+{
+    m_buffer->m_units.clear();
+
+    for (std::list<Unit*>::const_iterator itr = units.begin(); itr != units.end(); ++itr)
+        if (*itr)
+            m_buffer->m_units.push_back(*itr);
+}
+
+void SpellAreaQuery::Remove(Unit* unit)
+{
+    UnitVector& units = m_buffer->m_units;
+    units.erase(std::remove(units.begin(), units.end(), unit), units.end());
+}
+
+bool SpellAreaQuery::Contains(Unit const* unit) const
+{
+    UnitVector const& units = m_buffer->m_units;
+    return std::find(units.begin(), units.end(), unit) != units.end();
+}
+
+void SpellAreaQuery::KeepFarthest(WorldObject const* origin, uint32 count)
+{
+    UnitVector& units = m_buffer->m_units;
+    if (units.size() <= count)
+        return;
+
+    std::nth_element(units.begin(), units.begin() + count, units.end(), DistanceOrderFar(origin));
+    units.resize(count);
+}
+
+void SpellAreaQuery::KeepRandom(uint32 count, Unit* keep /*=NULL*/)
+{
+    UnitVector& units = m_buffer->m_units;
+    if (units.size() <= count)
+        return;
+
+    size_t oldSize = units.size();
+    if (keep)
+        Remove(keep);
+
+    bool kept = units.size() != oldSize;
+    if (kept && count)
+        --count;
+
+    // drop random units, removed ones are marked NULL so the survivors keep their order
+    for (size_t left = units.size(); left > count;)
+    {
+        Unit*& unit = units[urand(0, uint32(units.size()) - 1)];
+        if (unit)
+        {
+            unit = NULL;
+            --left;
+        }
+    }
+
+    units.erase(std::remove(units.begin(), units.end(), (Unit*)NULL), units.end());
+
+    if (kept)
+        units.push_back(keep);
+}
+
+Unit* SpellAreaQuery::TakeRandomInRange(WorldObject const* origin, float radius)
+{
+    UnitVector& units = m_buffer->m_units;
+
+    UnitVector::iterator inRangeEnd = std::partition(units.begin(), units.end(), WithinDistOf(origin, radius));
+    if (inRangeEnd == units.begin())
+        return NULL;
+
+    UnitVector::iterator itr = units.begin() + urand(0, uint32(inRangeEnd - units.begin()) - 1);
+    Unit* unit = *itr;
+    units.erase(itr);
+    return unit;
+}
+
+void SpellAreaQuery::SelectChain(Unit* first, uint32 maxTargets, float jumpRadius, bool checkLos, bool skipFullHealth, std::list<Unit*>& targets)
+{
+    UnitVector& units = m_buffer->m_units;
+
+    Remove(first);
+    targets.push_back(first);
+
+    Unit* prev = first;
+    for (uint32 left = maxTargets > 1 ? maxTargets - 1 : 0; left; --left)
+    {
+        // only units in jump range can be next, move them to the front, nearest first
+        UnitVector::iterator inRangeEnd = std::partition(units.begin(), units.end(), WithinDistOf(prev, jumpRadius));
+        std::sort(units.begin(), inRangeEnd, DistanceOrderNear(prev));
+
+        Unit* next = NULL;
+        for (UnitVector::iterator itr = units.begin(); itr != inRangeEnd; ++itr)
+        {
+            if (checkLos && !prev->IsWithinLOSInMap(*itr))
+                continue;
+
+            // units at full health are no chain targets at all
+            if (skipFullHealth && (*itr)->GetHealth() == (*itr)->GetMaxHealth())
+            {
+                *itr = NULL;
+                continue;
+            }
+
+            next = *itr;
+            *itr = NULL;
+            break;
+        }
+
+        units.erase(std::remove(units.begin(), inRangeEnd, (Unit*)NULL), inRangeEnd);
+
+        if (!next)
+            break;
+
+        targets.push_back(next);
+        prev = next;
+    }
+}
+
+void SpellAreaQuery::AppendTo(std::list<Unit*>& targets) const
+{
+    targets.insert(targets.end(), m_buffer->m_units.begin(), m_buffer->m_units.end());
+}
@@ -0,0 +1,103 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SPELLAREAQUERY_H
+#define MANGOS_SPELLAREAQUERY_H
+
+#include "Common.h"
+#include "Platform/Define.h"
+#include "MapPositionIndex.h"
+#include "Spell.h"
+
+#include <vector>
+#include <list>
+
+class Map;
+class Unit;
+class WorldObject;
+
+/**
+ * Spell area target selection over the map position index.
+ *
+ * Candidates come from one MapPositionIndex range query, the units accepted by
+ * the target checks are kept in a contiguous array and the shape operations
+ * (cone, chain, farthest or random N) work on that array. Both arrays are borrowed
+ * from the map, so a cast doesn't allocate once they reached their usual size;
+ * the result is only copied into the spell target list at the end.
+ * Must only be used from the thread updating the map.
+ */
+class SpellAreaQuery
+{
+    public:
+        typedef std::vector<Unit*> UnitVector;
+
+        explicit SpellAreaQuery(Map& map);
+        ~SpellAreaQuery();
+
+        // add units around center accepted by check, the check does the exact range and phase test
+        template<class Check>
+        void SelectInRange(WorldObject const* center, float radius, Check& check)
+        {
+            Query(center->GetPositionX(), center->GetPositionY(), radius + center->GetObjectBoundingRadius());
+
+            for (std::vector<WorldObject*>::const_iterator itr = m_buffer->m_candidates.begin(); itr != m_buffer->m_candidates.end(); ++itr)
+                if (check((Unit*)*itr))
+                    m_buffer->m_units.push_back((Unit*)*itr);
+        }
+
+        // add area spell targets, circle and cone shapes by pushType
+        // same rules as Cell::VisitAllObjects with MaNGOS::SpellNotifierCreatureAndPlayer
+        void SelectSpellTargets(Spell& spell, float radius, SpellNotifyPushType pushType, SpellTargets spellTargets, WorldObject* originalCaster = NULL);
+
+        // replace the selection by the units of a spell target list
+        void Assign(std::list<Unit*> const& units);
+
+        void Add(Unit* unit) { m_buffer->m_units.push_back(unit); }
+        void Remove(Unit* unit);
+        bool Contains(Unit const* unit) const;
+
+        // cut the selection down to the count units farthest away from origin, in no particular order
+        void KeepFarthest(WorldObject const* origin, uint32 count);
+        // cut the selection down to count random units, keeping their order
+        // keep (if selected) is never removed and moved to the end, like the spell's unit target
+        void KeepRandom(uint32 count, Unit* keep = NULL);
+
+        // remove and return a random selected unit within radius of origin, NULL if there is none
+        Unit* TakeRandomInRange(WorldObject const* origin, float radius);
+
+        // chain from first: every jump goes to the nearest selected unit within jumpRadius of the previous target
+        // first and the jumped to units are added to targets and removed from the selection
+        // checkLos skips units out of line of sight of the previous target, skipFullHealth drops units at full health
+        void SelectChain(Unit* first, uint32 maxTargets, float jumpRadius, bool checkLos, bool skipFullHealth, std::list<Unit*>& targets);
+
+        UnitVector const& GetUnits() const { return m_buffer->m_units; }
+        void AppendTo(std::list<Unit*>& targets) const;
+
+    private:
+        // fill the candidate array with the units within radius of the point, 2D
+        void Query(float x, float y, float radius);
+
+        Map& m_map;
+        MapQueryBuffer* m_buffer;                           // map buffer, or m_ownBuffer for nested queries
+        MapQueryBuffer m_ownBuffer;
+
+        SpellAreaQuery(SpellAreaQuery const&);
+        SpellAreaQuery& operator=(SpellAreaQuery const&);
+};
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SpellAuraProcIndex.h"
+#include "Unit.h"
+#include "SpellAuras.h"
+#include "SpellMgr.h"
+
+#include <algorithm>
+
+namespace
+{
+    struct HolderSpellIdLess
+    {
+        bool operator()(SpellAuraHolder const* a, SpellAuraHolder const* b) const
+        {
+            return a->GetId() < b->GetId();
+        }
+    };
+
+    void RemoveFromBucket(std::vector<SpellAuraHolder*>& bucket, SpellAuraHolder* holder)
+    {
+        std::vector<SpellAuraHolder*>::iterator itr = std::find(bucket.begin(), bucket.end(), holder);
+        if (itr != bucket.end())
+            bucket.erase(itr);                              // keep insertion order, buckets are small
+    }
+}
+
+SpellAuraProcIndex::SpellAuraProcIndex() : m_procFlagMask(0), m_generation(0)
+{
+}
+
+uint32 SpellAuraProcIndex::GetHolderProcFlags(SpellAuraHolder const* holder)
+{
+    SpellProcEventEntry const* spellProcEvent = sSpellMgr.GetSpellProcEvent(holder->GetId());
+    if (spellProcEvent && spellProcEvent->procFlags)
+        return spellProcEvent->procFlags;
+
+    return holder->GetSpellProto()->GetProcFlags();
+}
+
+bool SpellAuraProcIndex::IsIndexed(SpellAuraHolder const* holder)
+{
+    return GetHolderProcFlags(holder) || (holder->GetSpellProto()->GetAuraInterruptFlags() & AURA_INTERRUPT_FLAG_DAMAGE);
+}
+
+void SpellAuraProcIndex::Insert(SpellAuraHolder* holder)
+{
+    if (uint32 procFlags = GetHolderProcFlags(holder))
+    {
+        for (uint32 i = 0; i < MAX_PROC_FLAG_BITS; ++i)
+            if (procFlags & (uint32(1) << i))
+                m_buckets[i].push_back(holder);
+
+        m_procFlagMask |= procFlags;
+    }
+
+    if (holder->GetSpellProto()->GetAuraInterruptFlags() & AURA_INTERRUPT_FLAG_DAMAGE)
+        m_damageInterrupted.push_back(holder);
+}
+
+void SpellAuraProcIndex::Remove(SpellAuraHolder* holder)
+{
+    // don't trust the current proc flags, spell_proc_event may have been reloaded since insert
+    for (uint32 i = 0; i < MAX_PROC_FLAG_BITS; ++i)
+    {
+        if (!(m_procFlagMask & (uint32(1) << i)))
+            continue;
+
+        RemoveFromBucket(m_buckets[i], holder);
+        if (m_buckets[i].empty())
+            m_procFlagMask &= ~(uint32(1) << i);
+    }
+
+    RemoveFromBucket(m_damageInterrupted, holder);
+}
+
+void SpellAuraProcIndex::Clear()
+{
+    for (uint32 i = 0; i < MAX_PROC_FLAG_BITS; ++i)
+        m_buckets[i].clear();
+
+    m_damageInterrupted.clear();
+    m_procFlagMask = 0;
+}
+
+void SpellAuraProcIndex::GetCandidates(uint32 procFlag, bool damageTaken, std::vector<SpellAuraHolder*>& result) const
+{
+    size_t start = result.size();
+    uint32 bits = procFlag & m_procFlagMask;
+
+    for (uint32 i = 0; bits; ++i)
+    {
+        if (!(bits & (uint32(1) << i)))
+            continue;
+
+        bits &= ~(uint32(1) << i);
+
+        HolderBucket const& bucket = m_buckets[i];
+        if (result.size() == start)
+        {
+            result.insert(result.end(), bucket.begin(), bucket.end());
+            continue;
+        }
+
+        // a holder with several proc flags is in several buckets
+        for (HolderBucket::const_iterator itr = bucket.begin(); itr != bucket.end(); ++itr)
+            if (std::find(result.begin() + start, result.end(), *itr) == result.end())
+                result.push_back(*itr);
+    }
+
+    if (damageTaken)
+    {
+        for (HolderBucket::const_iterator itr = m_damageInterrupted.begin(); itr != m_damageInterrupted.end(); ++itr)
+            if (result.size() == start || std::find(result.begin() + start, result.end(), *itr) == result.end())
+                result.push_back(*itr);
+    }
+
+    std::stable_sort(result.begin() + start, result.end(), HolderSpellIdLess());
+}
+
+uint32 SpellAuraProcIndex::GetSize() const
+{
+    uint32 size = m_damageInterrupted.size();
+    for (uint32 i = 0; i < MAX_PROC_FLAG_BITS; ++i)
+        size += m_buckets[i].size();
+    return size;
+}
@@ -0,0 +1,75 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SPELLAURAPROCINDEX_H
+#define MANGOS_SPELLAURAPROCINDEX_H
+
+#include "Common.h"
+#include "Platform/Define.h"
+
+#include <vector>
+
+class SpellAuraHolder;
+
+#define MAX_PROC_FLAG_BITS 32
+
+/**
+ * Per unit index of the aura holders that can react to a proc event.
+ *
+ * Holders are bucketed by the bits of their proc flags (spell_proc_event flags
+ * if set, else the spell's own), so Unit::ProcDamageAndSpellFor only checks the
+ * holders of the buckets hit by the event instead of every applied aura. Holders
+ * removed by taken damage get an own bucket, they are handled by the same loop.
+ * The index is kept in sync by Unit::AddSpellAuraHolder/RemoveSpellAuraHolder.
+ */
+class SpellAuraProcIndex
+{
+    public:
+        SpellAuraProcIndex();
+
+        void Insert(SpellAuraHolder* holder);
+        void Remove(SpellAuraHolder* holder);
+        void Clear();
+
+        // append holders that may proc from procFlag, plus damage interrupted holders if damageTaken
+        // the result is ordered by spell id, like the holder map of the unit
+        void GetCandidates(uint32 procFlag, bool damageTaken, std::vector<SpellAuraHolder*>& result) const;
+
+        bool IsEmpty() const { return !m_procFlagMask && m_damageInterrupted.empty(); }
+        uint32 GetProcFlagMask() const { return m_procFlagMask; }
+        uint32 GetSize() const;                             // bucket entries, not distinct holders
+
+        // spell_proc_event state the buckets were built with, see SpellMgr::GetSpellProcEventGeneration
+        uint32 GetGeneration() const { return m_generation; }
+        void SetGeneration(uint32 generation) { m_generation = generation; }
+
+        // proc flags used for bucketing, same choice as Unit::IsTriggeredAtSpellProcEvent
+        static uint32 GetHolderProcFlags(SpellAuraHolder const* holder);
+        // holder would be put in any bucket
+        static bool IsIndexed(SpellAuraHolder const* holder);
+
+    private:
+        typedef std::vector<SpellAuraHolder*> HolderBucket;
+
+        HolderBucket m_buckets[MAX_PROC_FLAG_BITS];
+        HolderBucket m_damageInterrupted;
+        uint32 m_procFlagMask;                              // bits with non empty bucket
+        uint32 m_generation;
+};
+
+#endif
@@ -921,11 +921,26 @@ void Aura::ApplyModifier(bool apply, bool Real)
     GetHolder()->SetInUse(true);
     SetInUse(true);
     if (aura < TOTAL_AURAS)
+    {
+        // handlers often adjust m_modifier itself, cached modifiers of the target can't be trusted meanwhile
+        Unit* target = GetTarget();
+        target->BeginAuraModifierUpdate();
         (*this.*AuraHandler [aura])(apply, Real);
+        target->EndAuraModifierUpdate(aura);
+    }
     SetInUse(false);
     GetHolder()->SetInUse(false);
 }
 
+void Aura::ChangeAmount(int32 amount, bool update /*= true*/)
+{
+    m_modifier.m_amount = amount;
+    GetTarget()->InvalidateAuraModifierCache(m_modifier.m_auraname);
+
+    if (update)
+        GetHolder()->SendAuraUpdate(false);
+}
+
 bool Aura::isAffectedOnSpell(SpellEntry const* spell) const
 {
     return spell->IsFitToFamily(GetSpellProto()->GetSpellFamilyName(), GetAuraSpellClassMask());
@@ -1909,7 +1924,7 @@ void Aura::TriggerSpell()
                         // Reset reapply counter at move
                         if (((Player*)triggerTarget)->isMoving())
                         {
-                            m_modifier.m_amount = 6;
+                            ChangeAmount(6, false);
                             return;
                         }
 
@@ -8465,7 +8480,7 @@ void Aura::PeriodicDummyTick()
                 // Search SPELL_AURA_MOD_POWER_REGEN aura for this spell and add bonus
                 if (Aura* aura = GetHolder()->GetAuraByEffectIndex(SpellEffectIndex(GetEffIndex() - 1)))
                 {
-                    aura->GetModifier()->m_amount = m_modifier.m_amount;
+                    aura->ChangeAmount(m_modifier.m_amount, false);
                     ((Player*)target)->UpdateManaRegen();
                     // Disable continue
                     m_isPeriodic = false;
@@ -41,7 +41,7 @@ bool IsPrimaryProfessionSkill(uint32 skill)
     return true;
 }
 
-SpellMgr::SpellMgr()
+SpellMgr::SpellMgr() : mSpellProcEventGeneration(0)
 {
 }
 
@@ -736,6 +736,15 @@ bool IsExplicitNegativeTarget(uint32 targetA)
 }
 
 bool IsPositiveEffect(SpellEntry const* spellproto, SpellEffectIndex effIndex)
+{
+    SpellInfo const* info = spellproto->GetInfo();
+    if (info && info->HasDerivedFlags())
+        return info->IsPositiveEffect(effIndex);
+
+    return CalculatePositiveEffect(spellproto, effIndex);
+}
+
+bool CalculatePositiveEffect(SpellEntry const* spellproto, SpellEffectIndex effIndex)
 {
     SpellEffectEntry const* spellEffect = spellproto->GetSpellEffect(effIndex);
 
@@ -1033,6 +1042,10 @@ bool IsPositiveSpell(uint32 spellId)
 
 bool IsPositiveSpell(SpellEntry const* spellproto)
 {
+    SpellInfo const* info = spellproto->GetInfo();
+    if (info && info->HasDerivedFlags())
+        return info->IsPositive();
+
     // spells with at least one negative effect are considered negative
     // some self-applied spells have negative effects but in self casting case negative check ignored.
     for (int i = 0; i < MAX_EFFECT_INDEX; ++i)
@@ -1406,6 +1419,7 @@ struct DoSpellProcEvent
 void SpellMgr::LoadSpellProcEvents()
 {
     mSpellProcEventMap.clear();                             // need for reload case
+    ++mSpellProcEventGeneration;
 
     //                                                0      1           2                3                  4                  5                  6                  7                  8                  9                  10                 11                 12         13      14       15            16
     QueryResult* result = WorldDatabase.Query("SELECT entry, SchoolMask, SpellFamilyName, SpellFamilyMaskA0, SpellFamilyMaskA1, SpellFamilyMaskA2, SpellFamilyMaskB0, SpellFamilyMaskB1, SpellFamilyMaskB2, SpellFamilyMaskC0, SpellFamilyMaskC1, SpellFamilyMaskC2, procFlags, procEx, ppmRate, CustomChance, Cooldown FROM spell_proc_event");
@@ -299,6 +299,8 @@ inline bool IsNonCombatSpell(SpellEntry const* spellInfo)
 bool IsPositiveSpell(uint32 spellId);
 bool IsPositiveSpell(SpellEntry const* spellproto);
 bool IsPositiveEffect(SpellEntry const* spellInfo, SpellEffectIndex effIndex);
+// IsPositiveEffect() without the SpellInfo flags, used to build them
+bool CalculatePositiveEffect(SpellEntry const* spellInfo, SpellEffectIndex effIndex);
 bool IsPositiveTarget(uint32 targetA, uint32 targetB);
 
 bool IsExplicitPositiveTarget(uint32 targetA);
@@ -433,6 +435,10 @@ inline bool IsAreaEffectTarget(Targets target)
 
 inline bool IsAreaOfEffectSpell(SpellEntry const* spellInfo)
 {
+    SpellInfo const* info = spellInfo->GetInfo();
+    if (info && info->HasDerivedFlags())
+        return info->IsAreaOfEffect();
+
     SpellEffectEntry const* effectEntry = spellInfo->GetSpellEffect(EFFECT_INDEX_0);
     if(effectEntry && (IsAreaEffectTarget(Targets(effectEntry->EffectImplicitTargetA)) || IsAreaEffectTarget(Targets(effectEntry->EffectImplicitTargetB))))
         return true;
@@ -1034,6 +1040,9 @@ class SpellMgr
             return NULL;
         }
 
+        // changes with every spell_proc_event (re)load, units rebuild their proc index on change
+        uint32 GetSpellProcEventGeneration() const { return mSpellProcEventGeneration; }
+
         // Spell procs from item enchants
         float GetItemEnchantProcChance(uint32 spellid) const
         {
@@ -1272,6 +1281,7 @@ class SpellMgr
         SpellElixirMap     mSpellElixirs;
         SpellThreatMap     mSpellThreatMap;
         SpellProcEventMap  mSpellProcEventMap;
+        uint32             mSpellProcEventGeneration;
         SpellProcItemEnchantMap mSpellProcItemEnchantMap;
         SpellBonusMap      mSpellBonusMap;
         SkillLineAbilityMap mSkillLineAbilityMap;
@@ -31,6 +31,7 @@
 #include "Spell.h"
 #include "Group.h"
 #include "SpellAuras.h"
+#include "SpellAuraProcIndex.h"
 #include "MapManager.h"
 #include "ObjectAccessor.h"
 #include "CreatureAI.h"
@@ -135,9 +136,12 @@ Unit::Unit() :
     // m_AurasCheck = 2000;
     // m_removeAuraTimer = 4;
     m_spellAuraHoldersUpdateIterator = m_spellAuraHolders.end();
+    m_procIndex = NULL;
+    m_auraModifierUpdates = 0;
     m_AuraFlags = 0;
 
     m_Visibility = VISIBILITY_ON;
+    m_relocationQueueSlot = 0;
     m_AINotifyScheduled = false;
 
     m_detectInvisibilityMask = 0;
@@ -204,6 +208,7 @@ Unit::~Unit()
     delete m_charmInfo;
     delete m_vehicleInfo;
     delete movespline;
+    delete m_procIndex;
 
     // those should be already removed at "RemoveFromWorld()" call
     MANGOS_ASSERT(m_gameObj.size() == 0);
@@ -231,6 +236,7 @@ void Unit::Update(uint32 update_diff, uint32 p_time)
     _UpdateSpells(update_diff);
 
     CleanupDeletedAuras();
+    CompactModLists();
 
     if (CanHaveThreatList())
         getThreatManager().UpdateForClient(update_diff);
@@ -2181,9 +2187,7 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* pCaster, SpellSchoolMask schoolM
             incanterAbsorption += currentAbsorb;
 
         // Reduce shield amount
-        mod->m_amount -= currentAbsorb;
-        if ((*i)->GetHolder()->DropAuraCharge())
-            mod->m_amount = 0;
+        (*i)->ChangeAmount((*i)->GetHolder()->DropAuraCharge() ? 0 : mod->m_amount - currentAbsorb, false);
         // Need remove it later
         if (mod->m_amount <= 0)
             existExpired = true;
@@ -2247,7 +2251,7 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* pCaster, SpellSchoolMask schoolM
         if ((*i)->GetSpellProto()->IsFitToFamily(SPELLFAMILY_MAGE, UI64LIT(0x0000000000000000), 0x000008))
             incanterAbsorption += currentAbsorb;
 
-        (*i)->GetModifier()->m_amount -= currentAbsorb;
+        (*i)->ChangeAmount((*i)->GetModifier()->m_amount - currentAbsorb, false);
         if ((*i)->GetModifier()->m_amount <= 0)
         {
             RemoveAurasDueToSpell((*i)->GetId());
@@ -2414,9 +2418,7 @@ void Unit::CalculateHealAbsorb(const uint32 heal, uint32* absorb)
         RemainingHeal -= currentAbsorb;
 
         // Reduce aura amount
-        mod->m_amount -= currentAbsorb;
-        if ((*i)->GetHolder()->DropAuraCharge())
-            mod->m_amount = 0;
+        (*i)->ChangeAmount((*i)->GetHolder()->DropAuraCharge() ? 0 : mod->m_amount - currentAbsorb, false);
         // Need remove it later
         if (mod->m_amount <= 0)
             existExpired = true;
@@ -3619,46 +3621,58 @@ void Unit::DeMorph()
 int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
     int32 modifier = 0;
+    if (GetCachedAuraModifier(auratype, AURA_AGGREGATE_TOTAL, 0, modifier))
+        return modifier;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
         modifier += (*i)->GetModifier()->m_amount;
 
+    CacheAuraModifier(auratype, AURA_AGGREGATE_TOTAL, 0, modifier);
     return modifier;
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
     float multiplier = 1.0f;
+    if (GetCachedAuraModifier(auratype, AURA_AGGREGATE_MULTIPLIER, 0, multiplier))
+        return multiplier;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
         multiplier *= (100.0f + (*i)->GetModifier()->m_amount) / 100.0f;
 
+    CacheAuraModifier(auratype, AURA_AGGREGATE_MULTIPLIER, 0, multiplier);
     return multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
 {
     int32 modifier = 0;
+    if (GetCachedAuraModifier(auratype, AURA_AGGREGATE_MAX_POSITIVE, 0, modifier))
+        return modifier;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
         if ((*i)->GetModifier()->m_amount > modifier)
             modifier = (*i)->GetModifier()->m_amount;
 
+    CacheAuraModifier(auratype, AURA_AGGREGATE_MAX_POSITIVE, 0, modifier);
     return modifier;
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
     int32 modifier = 0;
+    if (GetCachedAuraModifier(auratype, AURA_AGGREGATE_MAX_NEGATIVE, 0, modifier))
+        return modifier;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
         if ((*i)->GetModifier()->m_amount < modifier)
             modifier = (*i)->GetModifier()->m_amount;
 
+    CacheAuraModifier(auratype, AURA_AGGREGATE_MAX_NEGATIVE, 0, modifier);
     return modifier;
 }
 
@@ -3668,6 +3682,8 @@ int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask)
         return 0;
 
     int32 modifier = 0;
+    if (GetCachedAuraModifier(auratype, AURA_AGGREGATE_TOTAL_BY_MISC_MASK, misc_mask, modifier))
+        return modifier;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
@@ -3676,6 +3692,7 @@ int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask)
         if (mod->m_miscvalue & misc_mask)
             modifier += mod->m_amount;
     }
+    CacheAuraModifier(auratype, AURA_AGGREGATE_TOTAL_BY_MISC_MASK, misc_mask, modifier);
     return modifier;
 }
 
@@ -3685,6 +3702,8 @@ float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask
         return 1.0f;
 
     float multiplier = 1.0f;
+    if (GetCachedAuraModifier(auratype, AURA_AGGREGATE_MULTIPLIER_BY_MISC_MASK, misc_mask, multiplier))
+        return multiplier;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
@@ -3693,6 +3712,7 @@ float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask
         if (mod->m_miscvalue & misc_mask)
             multiplier *= (100.0f + mod->m_amount) / 100.0f;
     }
+    CacheAuraModifier(auratype, AURA_AGGREGATE_MULTIPLIER_BY_MISC_MASK, misc_mask, multiplier);
     return multiplier;
 }
 
@@ -3702,6 +3722,8 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_
         return 0;
 
     int32 modifier = 0;
+    if (GetCachedAuraModifier(auratype, AURA_AGGREGATE_MAX_POSITIVE_BY_MISC_MASK, misc_mask, modifier))
+        return modifier;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
@@ -3711,6 +3733,7 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_
             modifier = mod->m_amount;
     }
 
+    CacheAuraModifier(auratype, AURA_AGGREGATE_MAX_POSITIVE_BY_MISC_MASK, misc_mask, modifier);
     return modifier;
 }
 
@@ -3720,6 +3743,8 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_
         return 0;
 
     int32 modifier = 0;
+    if (GetCachedAuraModifier(auratype, AURA_AGGREGATE_MAX_NEGATIVE_BY_MISC_MASK, misc_mask, modifier))
+        return modifier;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
@@ -3729,12 +3754,15 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_
             modifier = mod->m_amount;
     }
 
+    CacheAuraModifier(auratype, AURA_AGGREGATE_MAX_NEGATIVE_BY_MISC_MASK, misc_mask, modifier);
     return modifier;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
     int32 modifier = 0;
+    if (GetCachedAuraModifier(auratype, AURA_AGGREGATE_TOTAL_BY_MISC_VALUE, uint32(misc_value), modifier))
+        return modifier;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
@@ -3743,12 +3771,15 @@ int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value)
         if (mod->m_miscvalue == misc_value)
             modifier += mod->m_amount;
     }
+    CacheAuraModifier(auratype, AURA_AGGREGATE_TOTAL_BY_MISC_VALUE, uint32(misc_value), modifier);
     return modifier;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_value) const
 {
     float multiplier = 1.0f;
+    if (GetCachedAuraModifier(auratype, AURA_AGGREGATE_MULTIPLIER_BY_MISC_VALUE, uint32(misc_value), multiplier))
+        return multiplier;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
@@ -3757,12 +3788,15 @@ float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_valu
         if (mod->m_miscvalue == misc_value)
             multiplier *= (100.0f + mod->m_amount) / 100.0f;
     }
+    CacheAuraModifier(auratype, AURA_AGGREGATE_MULTIPLIER_BY_MISC_VALUE, uint32(misc_value), multiplier);
     return multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
     int32 modifier = 0;
+    if (GetCachedAuraModifier(auratype, AURA_AGGREGATE_MAX_POSITIVE_BY_MISC_VALUE, uint32(misc_value), modifier))
+        return modifier;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
@@ -3772,12 +3806,15 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_
             modifier = mod->m_amount;
     }
 
+    CacheAuraModifier(auratype, AURA_AGGREGATE_MAX_POSITIVE_BY_MISC_VALUE, uint32(misc_value), modifier);
     return modifier;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
     int32 modifier = 0;
+    if (GetCachedAuraModifier(auratype, AURA_AGGREGATE_MAX_NEGATIVE_BY_MISC_VALUE, uint32(misc_value), modifier))
+        return modifier;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
@@ -3787,6 +3824,7 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_
             modifier = mod->m_amount;
     }
 
+    CacheAuraModifier(auratype, AURA_AGGREGATE_MAX_NEGATIVE_BY_MISC_VALUE, uint32(misc_value), modifier);
     return modifier;
 }
 
@@ -3796,6 +3834,8 @@ float Unit::GetTotalAuraMultiplierByMiscValueForMask(AuraType auratype, uint32 m
         return 1.0f;
 
     float multiplier = 1.0f;
+    if (GetCachedAuraModifier(auratype, AURA_AGGREGATE_MULTIPLIER_BY_MISC_VALUE_FOR_MASK, mask, multiplier))
+        return multiplier;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
@@ -3804,9 +3844,84 @@ float Unit::GetTotalAuraMultiplierByMiscValueForMask(AuraType auratype, uint32 m
         if (mask & (1 << (mod->m_miscvalue - 1)))
             multiplier *= (100.0f + mod->m_amount) / 100.0f;
     }
+    CacheAuraModifier(auratype, AURA_AGGREGATE_MULTIPLIER_BY_MISC_VALUE_FOR_MASK, mask, multiplier);
     return multiplier;
 }
 
+void Unit::InvalidateAuraModifierCache(AuraType auratype)
+{
+    AuraModifierCache::iterator itr = m_auraModifierCache.find(auratype);
+    if (itr != m_auraModifierCache.end())
+        itr->second.clear();                                // keep the memory, the type is likely queried again
+}
+
+void Unit::EndAuraModifierUpdate(AuraType auratype)
+{
+    MANGOS_ASSERT(m_auraModifierUpdates);
+    --m_auraModifierUpdates;
+    InvalidateAuraModifierCache(auratype);
+}
+
+Unit::AuraModifierCacheEntry* Unit::FindAuraModifierCacheEntry(AuraType auratype, AuraModifierAggregate aggregate, uint32 misc) const
+{
+    AuraModifierCache::iterator itr = m_auraModifierCache.find(auratype);
+    if (itr == m_auraModifierCache.end())
+        return NULL;
+
+    for (AuraModifierCacheEntries::iterator entry = itr->second.begin(); entry != itr->second.end(); ++entry)
+        if (entry->aggregate == uint32(aggregate) && entry->misc == misc)
+            return &*entry;
+
+    return NULL;
+}
+
+bool Unit::GetCachedAuraModifier(AuraType auratype, AuraModifierAggregate aggregate, uint32 misc, int32& value) const
+{
+    // without auras the walk is cheaper than the lookup
+    if (m_auraModifierUpdates || m_modAuras[auratype].empty())
+        return false;
+
+    AuraModifierCacheEntry const* entry = FindAuraModifierCacheEntry(auratype, aggregate, misc);
+    if (!entry)
+        return false;
+
+    value = entry->value.i;
+    return true;
+}
+
+bool Unit::GetCachedAuraModifier(AuraType auratype, AuraModifierAggregate aggregate, uint32 misc, float& value) const
+{
+    if (m_auraModifierUpdates || m_modAuras[auratype].empty())
+        return false;
+
+    AuraModifierCacheEntry const* entry = FindAuraModifierCacheEntry(auratype, aggregate, misc);
+    if (!entry)
+        return false;
+
+    value = entry->value.f;
+    return true;
+}
+
+void Unit::CacheAuraModifier(AuraType auratype, AuraModifierAggregate aggregate, uint32 misc, int32 value) const
+{
+    if (m_auraModifierUpdates || m_modAuras[auratype].empty())
+        return;
+
+    AuraModifierCacheEntries& entries = m_auraModifierCache[auratype];
+    entries.push_back(AuraModifierCacheEntry(aggregate, misc));
+    entries.back().value.i = value;
+}
+
+void Unit::CacheAuraModifier(AuraType auratype, AuraModifierAggregate aggregate, uint32 misc, float value) const
+{
+    if (m_auraModifierUpdates || m_modAuras[auratype].empty())
+        return;
+
+    AuraModifierCacheEntries& entries = m_auraModifierCache[auratype];
+    entries.push_back(AuraModifierCacheEntry(aggregate, misc));
+    entries.back().value.f = value;
+}
+
 bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
 {
     SpellEntry const* aurSpellInfo = holder->GetSpellProto();
@@ -4024,6 +4139,16 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
     holder->_AddSpellAuraHolder();
     m_spellAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
 
+    if (m_procIndex || SpellAuraProcIndex::IsIndexed(holder))
+    {
+        if (!m_procIndex)
+        {
+            m_procIndex = new SpellAuraProcIndex();
+            m_procIndex->SetGeneration(sSpellMgr.GetSpellProcEventGeneration());
+        }
+        m_procIndex->Insert(holder);
+    }
+
     for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
             AddAuraToModList(aur);
@@ -4044,7 +4169,31 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
 void Unit::AddAuraToModList(Aura* aura)
 {
     if (aura->GetModifier()->m_auraname < TOTAL_AURAS)
+    {
         m_modAuras[aura->GetModifier()->m_auraname].push_back(aura);
+        InvalidateAuraModifierCache(aura->GetModifier()->m_auraname);
+    }
+}
+
+void Unit::RemoveAuraFromModList(AuraType type, Aura* aura)
+{
+    AuraList& modList = m_modAuras[type];
+    bool hadHoles = modList.HasHoles();
+
+    modList.remove(aura);
+    InvalidateAuraModifierCache(type);
+
+    if (!hadHoles && modList.HasHoles())
+        m_modAurasWithHoles.push_back(type);
+}
+
+void Unit::CompactModLists()
+{
+    // only called from Update, no mod list is iterated here
+    for (std::vector<AuraType>::const_iterator itr = m_modAurasWithHoles.begin(); itr != m_modAurasWithHoles.end(); ++itr)
+        m_modAuras[*itr].Compact();
+
+    m_modAurasWithHoles.clear();
 }
 
 void Unit::RemoveRankAurasDueToSpell(uint32 spellId)
@@ -4643,6 +4792,9 @@ void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
         }
     }
 
+    if (m_procIndex)
+        m_procIndex->Remove(holder);
+
     holder->SetRemoveMode(mode);
     holder->UnregisterAndCleanupTrackedAuras();
 
@@ -4694,7 +4846,7 @@ void Unit::RemoveAura(Aura* Aur, AuraRemoveMode mode)
     // remove from list before mods removing (prevent cyclic calls, mods added before including to aura list - use reverse order)
     if (Aur->GetModifier()->m_auraname < TOTAL_AURAS)
     {
-        m_modAuras[Aur->GetModifier()->m_auraname].remove(Aur);
+        RemoveAuraFromModList(Aur->GetModifier()->m_auraname, Aur);
     }
 
     // Set remove mode
@@ -8301,8 +8453,7 @@ void Unit::UpdateVisibilityAndView()
 
             if (!owner || !isVisibleForOrDetect(owner, this, false))
             {
-                alist.erase(it);
-                RemoveAura(aura);
+                RemoveAura(aura);                           // also removes it from alist
                 it = alist.begin();
             }
             else
@@ -9890,9 +10041,12 @@ void Unit::ApplyAuraProcTriggerDamage(Aura* aura, bool apply)
 {
     AuraList& tAuraProcTriggerDamage = m_modAuras[SPELL_AURA_PROC_TRIGGER_DAMAGE];
     if (apply)
+    {
         tAuraProcTriggerDamage.push_back(aura);
+        InvalidateAuraModifierCache(SPELL_AURA_PROC_TRIGGER_DAMAGE);
+    }
     else
-        tAuraProcTriggerDamage.remove(aura);
+        RemoveAuraFromModList(SPELL_AURA_PROC_TRIGGER_DAMAGE, aura);
 }
 
 uint32 Unit::GetCreatePowers(Powers power) const
@@ -9934,6 +10088,9 @@ uint32 Unit::GetCreateMaxPowers(Powers power) const
 
 void Unit::AddToWorld()
 {
+    if (!IsInWorld())
+        GetMap()->GetPositionIndex().Insert(this);
+
     Object::AddToWorld();
     ScheduleAINotify(0);
 }
@@ -9952,6 +10109,9 @@ void Unit::RemoveFromWorld()
         RemoveAllDynObjects();
         CleanupDeletedAuras();
         GetViewPoint().Event_RemovedFromWorld();
+
+        GetMap()->GetPositionIndex().Remove(this);
+        GetMap()->RemoveRelocatedUnit(this);
     }
 
     Object::RemoveFromWorld();
@@ -10320,16 +10480,23 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* pTarget, uint32 procFlag,
 
     RemoveSpellList removedSpells;
     ProcTriggeredList procTriggered;
+
+    // only holders with matching proc flags can trigger, the others only matter if removed by damage
+    std::vector<SpellAuraHolder*> candidates;
+    GetProcCandidates(procFlag, isVictim && (procFlag & PROC_FLAG_TAKEN_ANY_DAMAGE), candidates);
+
     // Fill procTriggered list
-    for (SpellAuraHolderMap::const_iterator itr = GetSpellAuraHolderMap().begin(); itr != GetSpellAuraHolderMap().end(); ++itr)
+    for (std::vector<SpellAuraHolder*>::const_iterator itr = candidates.begin(); itr != candidates.end(); ++itr)
     {
+        SpellAuraHolder* holder = *itr;
+
         // skip deleted auras (possible at recursive triggered call
-        if (itr->second->IsDeleted())
+        if (holder->IsDeleted())
             continue;
 
         SpellProcEventEntry const* spellProcEvent = NULL;
         // check if that aura is triggered by proc event (then it will be managed by proc handler)
-        if (!IsTriggeredAtSpellProcEvent(pTarget, itr->second, procSpell, procFlag, procExtra, attType, isVictim, spellProcEvent))
+        if (!IsTriggeredAtSpellProcEvent(pTarget, holder, procSpell, procFlag, procExtra, attType, isVictim, spellProcEvent))
         {
             // spell seem not managed by proc system, although some case need to be handled
 
@@ -10337,7 +10504,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* pTarget, uint32 procFlag,
             if (!isVictim || !(procFlag & PROC_FLAG_TAKEN_ANY_DAMAGE))
                 continue;
 
-            const SpellEntry* se = itr->second->GetSpellProto();
+            const SpellEntry* se = holder->GetSpellProto();
 
             // check if the aura is interruptible by damage
             if (se->GetAuraInterruptFlags() & AURA_INTERRUPT_FLAG_DAMAGE)
@@ -10348,8 +10515,8 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* pTarget, uint32 procFlag,
             continue;
         }
 
-        itr->second->SetInUse(true);                        // prevent holder deletion
-        procTriggered.push_back(ProcTriggeredData(spellProcEvent, itr->second));
+        holder->SetInUse(true);                             // prevent holder deletion
+        procTriggered.push_back(ProcTriggeredData(spellProcEvent, holder));
     }
 
     if (!procTriggered.empty())
@@ -10447,6 +10614,24 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* pTarget, uint32 procFlag,
     }
 }
 
+void Unit::GetProcCandidates(uint32 procFlag, bool damageTaken, std::vector<SpellAuraHolder*>& result)
+{
+    if (!m_procIndex)
+        return;
+
+    // spell_proc_event reloaded, proc flags of applied holders may have changed
+    uint32 generation = sSpellMgr.GetSpellProcEventGeneration();
+    if (m_procIndex->GetGeneration() != generation)
+    {
+        m_procIndex->Clear();
+        for (SpellAuraHolderMap::const_iterator itr = m_spellAuraHolders.begin(); itr != m_spellAuraHolders.end(); ++itr)
+            m_procIndex->Insert(itr->second);
+        m_procIndex->SetGeneration(generation);
+    }
+
+    m_procIndex->GetCandidates(procFlag, damageTaken, result);
+}
+
 SpellSchoolMask Unit::GetMeleeDamageSchoolMask() const
 {
     return SPELL_SCHOOL_MASK_NORMAL;
@@ -11406,6 +11591,17 @@ void Unit::ScheduleAINotify(uint32 delay)
 }
 
 void Unit::OnRelocated()
+{
+    // visibility is updated once per map relocation batch, however often the unit moved until then
+    if (IsInWorld())
+        GetMap()->AddRelocatedUnit(this);
+    else
+        UpdateVisibilityAfterRelocation();
+
+    ScheduleAINotify(World::GetRelocationAINotifyDelay());
+}
+
+void Unit::UpdateVisibilityAfterRelocation()
 {
     // switch to use G3D::Vector3 is good idea, maybe
     float dx = m_last_notified_position.x - GetPositionX();
@@ -11421,7 +11617,6 @@ void Unit::OnRelocated()
         GetViewPoint().Call_UpdateVisibilityForOwner();
         UpdateObjectVisibility();
     }
-    ScheduleAINotify(World::GetRelocationAINotifyDelay());
 }
 
 /**
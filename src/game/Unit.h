@@ -37,6 +37,7 @@
 #include "FollowerReference.h"
 #include "FollowerRefManager.h"
 #include "Utilities/EventProcessor.h"
+#include "Utilities/FlatList.h"
 #include "MotionMaster.h"
 #include "DBCStructure.h"
 #include "Path.h"
@@ -283,6 +284,7 @@ struct SpellEntryExt;
 
 class Aura;
 class SpellAuraHolder;
+class SpellAuraProcIndex;
 class Creature;
 class Spell;
 class DynamicObject;
@@ -1183,13 +1185,15 @@ struct SpellProcEventEntry;                                 // used only private
 
 class MANGOS_DLL_SPEC Unit : public WorldObject
 {
+        friend class Map;                                   // relocation queue slot
+
     public:
         typedef std::set<Unit*> AttackerSet;
         typedef std::multimap<uint32 /*spellId*/, SpellAuraHolder*> SpellAuraHolderMap;
         typedef std::pair<SpellAuraHolderMap::iterator, SpellAuraHolderMap::iterator> SpellAuraHolderBounds;
         typedef std::pair<SpellAuraHolderMap::const_iterator, SpellAuraHolderMap::const_iterator> SpellAuraHolderConstBounds;
         typedef std::list<SpellAuraHolder*> SpellAuraHolderList;
-        typedef std::list<Aura*> AuraList;
+        typedef FlatList<Aura*> AuraList;
         typedef std::list<DiminishingReturn> Diminishing;
         typedef std::set<uint32 /*playerGuidLow*/> ComboPointHolderSet;
         typedef std::map<uint8 /*slot*/, SpellAuraHolder* /*spellId*/> VisibleAuraMap;
@@ -1747,6 +1751,7 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
 
         bool AddSpellAuraHolder(SpellAuraHolder* holder);
         void AddAuraToModList(Aura* aura);
+        void RemoveAuraFromModList(AuraType type, Aura* aura);
 
         // removing specific aura stack
         void RemoveAura(Aura* aura, AuraRemoveMode mode = AURA_REMOVE_BY_DEFAULT);
@@ -1946,6 +1951,9 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
 
         SpellAuraHolderMap&       GetSpellAuraHolderMap()       { return m_spellAuraHolders; }
         SpellAuraHolderMap const& GetSpellAuraHolderMap() const { return m_spellAuraHolders; }
+        // append holders that may react to a proc event, see SpellAuraProcIndex
+        void GetProcCandidates(uint32 procFlag, bool damageTaken, std::vector<SpellAuraHolder*>& result);
+        SpellAuraProcIndex const* GetProcIndex() const { return m_procIndex; }
         AuraList const& GetAurasByType(AuraType type) const { return m_modAuras[type]; }
         void ApplyAuraProcTriggerDamage(Aura* aura, bool apply);
 
@@ -1967,6 +1975,13 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
         // misc have plain value but we check it fit to provided values mask (mask & (1 << (misc-1)))
         float GetTotalAuraMultiplierByMiscValueForMask(AuraType auratype, uint32 mask) const;
 
+        // the Get*AuraModifier*/Get*AuraMultiplier* results are cached per aura type until an aura
+        // of the type is added, removed, (re)applied or its amount is changed by Aura::ChangeAmount
+        void InvalidateAuraModifierCache(AuraType auratype);
+        // aura handlers may change amounts in place, the cache is bypassed while any handler runs
+        void BeginAuraModifierUpdate() { ++m_auraModifierUpdates; }
+        void EndAuraModifierUpdate(AuraType auratype);
+
         Aura* GetDummyAura(uint32 spell_id) const;
 
         uint32 m_AuraFlags;
@@ -2134,6 +2149,7 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
         bool IsAINotifyScheduled() const { return m_AINotifyScheduled;}
         void _SetAINotifyScheduled(bool on) { m_AINotifyScheduled = on;}       // only for call from RelocationNotifyEvent code
         void OnRelocated();
+        void UpdateVisibilityAfterRelocation();             // called for queued relocations by Map, or directly if not in world
 
         bool IsLinkingEventTrigger() const { return m_isCreatureLinkingTrigger; }
 
@@ -2168,6 +2184,7 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
         SpellAuraHolderMap::iterator m_spellAuraHoldersUpdateIterator; // != end() in Unit::m_spellAuraHolders update and point to next element
         AuraList m_deletedAuras;                            // auras removed while in ApplyModifier and waiting deleted
         SpellAuraHolderList m_deletedHolders;
+        SpellAuraProcIndex* m_procIndex;                    // created with the first holder that can proc
 
         // Store Auras for which the target must be tracked
         TrackedAuraTargetMap m_trackedAuraTargets[MAX_TRACKED_AURA_TYPES];
@@ -2182,6 +2199,49 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
         uint32 m_transform;
 
         AuraList m_modAuras[TOTAL_AURAS];
+        std::vector<AuraType> m_modAurasWithHoles;         // lists to compact at next update
+
+        enum AuraModifierAggregate
+        {
+            AURA_AGGREGATE_TOTAL,
+            AURA_AGGREGATE_MULTIPLIER,
+            AURA_AGGREGATE_MAX_POSITIVE,
+            AURA_AGGREGATE_MAX_NEGATIVE,
+            AURA_AGGREGATE_TOTAL_BY_MISC_MASK,
+            AURA_AGGREGATE_MULTIPLIER_BY_MISC_MASK,
+            AURA_AGGREGATE_MAX_POSITIVE_BY_MISC_MASK,
+            AURA_AGGREGATE_MAX_NEGATIVE_BY_MISC_MASK,
+            AURA_AGGREGATE_TOTAL_BY_MISC_VALUE,
+            AURA_AGGREGATE_MULTIPLIER_BY_MISC_VALUE,
+            AURA_AGGREGATE_MAX_POSITIVE_BY_MISC_VALUE,
+            AURA_AGGREGATE_MAX_NEGATIVE_BY_MISC_VALUE,
+            AURA_AGGREGATE_MULTIPLIER_BY_MISC_VALUE_FOR_MASK
+        };
+
+        struct AuraModifierCacheEntry
+        {
+            AuraModifierCacheEntry(uint32 _aggregate, uint32 _misc) : aggregate(_aggregate), misc(_misc) { value.i = 0; }
+
+            uint32 aggregate;                               // AuraModifierAggregate
+            uint32 misc;                                    // misc mask or value, 0 if unused
+            union
+            {
+                int32 i;
+                float f;
+            } value;
+        };
+
+        typedef std::vector<AuraModifierCacheEntry> AuraModifierCacheEntries;
+        typedef UNORDERED_MAP<uint32 /*AuraType*/, AuraModifierCacheEntries> AuraModifierCache;
+
+        AuraModifierCacheEntry* FindAuraModifierCacheEntry(AuraType auratype, AuraModifierAggregate aggregate, uint32 misc) const;
+        bool GetCachedAuraModifier(AuraType auratype, AuraModifierAggregate aggregate, uint32 misc, int32& value) const;
+        bool GetCachedAuraModifier(AuraType auratype, AuraModifierAggregate aggregate, uint32 misc, float& value) const;
+        void CacheAuraModifier(AuraType auratype, AuraModifierAggregate aggregate, uint32 misc, int32 value) const;
+        void CacheAuraModifier(AuraType auratype, AuraModifierAggregate aggregate, uint32 misc, float value) const;
+
+        mutable AuraModifierCache m_auraModifierCache;
+        uint32 m_auraModifierUpdates;                       // nested Aura::ApplyModifier calls on this unit
         float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
         float m_weaponDamage[MAX_ATTACK][2];
         bool m_canModifyStats;
@@ -2207,6 +2267,7 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
 
     private:
         void CleanupDeletedAuras();
+        void CompactModLists();
         void UpdateSplineMovement(uint32 t_diff);
 
         // player or player's pet
@@ -2227,6 +2288,7 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
 
         UnitVisibility m_Visibility;
         Position m_last_notified_position;
+        uint32 m_relocationQueueSlot;                       // index in map relocation queue, valid only while queued
         bool m_AINotifyScheduled;
         ShortTimeTracker m_movesplineTimer;
 
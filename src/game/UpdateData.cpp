@@ -24,7 +24,9 @@
 #include "Opcodes.h"
 #include "World.h"
 #include "ObjectGuid.h"
+#include "Player.h"
 #include <zlib/zlib.h>
+#include <ace/TSS_T.h>
 
 UpdateData::UpdateData(uint16 map) : m_blockCount(0), m_map(map)
 {
@@ -46,60 +48,93 @@ void UpdateData::AddUpdateBlock(const ByteBuffer& block)
     ++m_blockCount;
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+/// Deflate stream of one thread, reset between packets instead of doing deflateInit/deflateEnd for each
+class UpdateDataDeflateStream
 {
-    z_stream c_stream;
+    public:
+        UpdateDataDeflateStream() : m_level(-1)
+        {
+            memset(&m_stream, 0, sizeof(m_stream));
+        }
 
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+        ~UpdateDataDeflateStream()
+        {
+            if (m_level >= 0)
+                deflateEnd(&m_stream);
+        }
 
-    // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+        z_stream* GetStream(int level)
+        {
+            if (m_level == level)
+                return &m_stream;
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+            // first use or compression level changed at config reload
+            if (m_level >= 0)
+                deflateEnd(&m_stream);
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+            m_level = -1;
+
+            memset(&m_stream, 0, sizeof(m_stream));
+            int z_res = deflateInit(&m_stream, level);
+            if (z_res != Z_OK)
+            {
+                sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                return NULL;
+            }
+
+            m_level = level;
+            return &m_stream;
+        }
 
-    if (c_stream.avail_in != 0)
+    private:
+        z_stream m_stream;
+        int m_level;                                        // level of m_stream, -1 if not initialized
+};
+
+typedef ACE_TSS<UpdateDataDeflateStream> UpdateDataDeflateStreamTSS;
+static UpdateDataDeflateStreamTSS deflateStream;
+
+static ACE_Thread_Mutex compressionStatsLock;
+static UpdateDataCompressionStats compressionStats;
+
+UpdateDataCompressionStats UpdateData::GetCompressionStats()
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(compressionStatsLock);
+    return compressionStats;
+}
+
+void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+{
+    // default Z_BEST_SPEED (1)
+    z_stream* c_stream = deflateStream->GetStream(sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
+    if (!c_stream)
     {
-        sLog.outError("Can't compress update packet (zlib: deflate not greedy)");
         *dst_size = 0;
         return;
     }
 
-    z_res = deflate(&c_stream, Z_FINISH);
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = *dst_size;
+    c_stream->next_in = (Bytef*)src;
+    c_stream->avail_in = (uInt)src_size;
+
+    // dst is compressBound() sized, so whole packet is done in one call
+    int z_res = deflate(c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         sLog.outError("Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
-        return;
     }
+    else
+        *dst_size = c_stream->total_out;
 
-    z_res = deflateEnd(&c_stream);
+    // keep the allocated state for next packet
+    z_res = deflateReset(c_stream);
     if (z_res != Z_OK)
     {
-        sLog.outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
+        sLog.outError("Can't compress update packet (zlib: deflateReset) Error code: %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
-        return;
     }
-
-    *dst_size = c_stream.total_out;
 }
 
 bool UpdateData::BuildPacket(WorldPacket* packet)
@@ -124,25 +159,40 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
 
     size_t pSize = buf.wpos();                              // use real used data size
 
-    //if (pSize > 100)                                        // compress large packets
-    //{
-    //    uint32 destsize = compressBound(pSize);
-    //    packet->resize(destsize + sizeof(uint32));
+    // compress large packets, only possible if client opcode is known
+    uint32 threshold = sWorld.getConfig(CONFIG_UINT32_COMPRESSION_THRESHOLD);
+    if (threshold && pSize >= threshold && serverOpcodeTable[SMSG_COMPRESSED_UPDATE_OBJECT].status != STATUS_UNHANDLED)
+    {
+        ACE_Time_Value startTime = ACE_OS::gettimeofday();
+
+        uint32 destsize = compressBound(pSize);
+        packet->resize(destsize + sizeof(uint32));
 
-    //    packet->put<uint32>(0, pSize);
-    //    Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
-    //    if (destsize == 0)
-    //        return false;
+        packet->put<uint32>(0, pSize);
+        Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
 
-    //    packet->resize(destsize + sizeof(uint32));
-    //    packet->SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
-    //}
-    //else                                                    // send small packets without compression
-    {
-        packet->append(buf);
-        packet->SetOpcode(SMSG_UPDATE_OBJECT);
+        // send uncompressed at failure or if nothing is saved
+        if (destsize != 0 && destsize + sizeof(uint32) < pSize)
+        {
+            packet->resize(destsize + sizeof(uint32));
+            packet->SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
+
+            ACE_Time_Value spentTime = ACE_OS::gettimeofday() - startTime;
+
+            ACE_Guard<ACE_Thread_Mutex> guard(compressionStatsLock);
+            ++compressionStats.packets;
+            compressionStats.rawBytes += pSize;
+            compressionStats.compressedBytes += packet->size();
+            compressionStats.compressTime += spentTime.usec() + uint64(spentTime.sec()) * 1000000;
+            return true;
+        }
+
+        packet->clear();
     }
 
+    packet->append(buf);
+    packet->SetOpcode(SMSG_UPDATE_OBJECT);
+
     return true;
 }
 
@@ -153,3 +203,54 @@ void UpdateData::Clear()
     m_blockCount = 0;
     m_map = 0;
 }
+
+UpdateData& UpdateDataBatch::GetUpdateData(Player* player)
+{
+    // slot stays valid as long as this batch was not sent since the player was added
+    uint32 slot = player->m_updateBatchSlot;
+    if (player->m_updateBatch == this && slot < m_size && m_slots[slot].m_player == player)
+        return m_slots[slot].m_data;
+
+    if (m_size == m_slots.size())
+        m_slots.push_back(Slot());
+
+    slot = m_size++;
+
+    Slot& newSlot = m_slots[slot];
+    newSlot.m_player = player;
+    newSlot.m_data.SetMapId(player->GetMapId());
+
+    player->m_updateBatch = this;
+    player->m_updateBatchSlot = slot;
+
+    return newSlot.m_data;
+}
+
+void UpdateDataBatch::SendAndClear()
+{
+    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
+    for (uint32 i = 0; i < m_size; ++i)
+    {
+        Slot& slot = m_slots[i];
+
+        slot.m_data.BuildPacket(&packet);
+        slot.m_player->GetSession()->SendPacket(&packet);
+        packet.clear();                                     // clean the string
+
+        slot.m_data.Clear();
+        slot.m_player = NULL;
+    }
+
+    m_size = 0;
+}
+
+void UpdateDataBatch::Clear()
+{
+    for (uint32 i = 0; i < m_size; ++i)
+    {
+        m_slots[i].m_data.Clear();
+        m_slots[i].m_player = NULL;
+    }
+
+    m_size = 0;
+}
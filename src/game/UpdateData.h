@@ -22,7 +22,10 @@
 #include "ByteBuffer.h"
 #include "ObjectGuid.h"
 
+#include <deque>
+
 class WorldPacket;
+class Player;
 
 enum ObjectUpdateType
 {
@@ -52,6 +55,17 @@ enum ObjectUpdateFlags
     UPDATEFLAG_UNK2                 = 0x4000,
 };
 
+/// Totals of update packets sent as SMSG_COMPRESSED_UPDATE_OBJECT, for all threads
+struct UpdateDataCompressionStats
+{
+    UpdateDataCompressionStats() : packets(0), rawBytes(0), compressedBytes(0), compressTime(0) {}
+
+    uint64 packets;
+    uint64 rawBytes;                                        // packet sizes before compression
+    uint64 compressedBytes;                                 // packet sizes as sent
+    uint64 compressTime;                                    // microseconds spent in deflate
+};
+
 class UpdateData
 {
     public:
@@ -68,12 +82,53 @@ class UpdateData
 
         void SetMapId(uint16 mapId) { m_map = mapId; }
 
+        static UpdateDataCompressionStats GetCompressionStats();
+
     protected:
         uint16 m_map;
         uint32 m_blockCount;
         GuidSet m_outOfRangeGUIDs;
         ByteBuffer m_data;
 
-        void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+        static void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+};
+
+/**
+ * Collects per player UpdateData while changed objects are flushed to clients.
+ *
+ * Each player remembers its slot in the batch it was added to last, so finding
+ * the player's UpdateData is a direct index access instead of a map lookup.
+ * Slots keep their buffers after SendAndClear() and are reused by the next flush.
+ */
+class UpdateDataBatch
+{
+    public:
+        UpdateDataBatch() : m_size(0) {}
+
+        UpdateData& GetUpdateData(Player* player);
+        // send one update packet to every collected player and reset the batch
+        void SendAndClear();
+        // drop the collected data without sending it
+        void Clear();
+
+        bool IsEmpty() const { return m_size == 0; }
+        uint32 GetSize() const { return m_size; }
+
+    private:
+        UpdateDataBatch(UpdateDataBatch const&);
+        UpdateDataBatch& operator=(UpdateDataBatch const&);
+
+        struct Slot
+        {
+            Slot() : m_player(NULL), m_data(0) {}
+
+            Player* m_player;
+            UpdateData m_data;
+        };
+
+        typedef std::deque<Slot> SlotList;
+
+        SlotList m_slots;                                   // never shrinks, only first m_size slots are in use
+        uint32 m_size;
 };
 #endif
@@ -69,6 +69,7 @@
 #include "CharacterDatabaseCleaner.h"
 #include "CreatureLinkingMgr.h"
 #include "Calendar.h"
+#include "WorldLoader.h"
 
 INSTANTIATE_SINGLETON_1(World);
 
@@ -88,6 +89,7 @@ float World::m_VisibleObjectGreyDistance      = 0;
 
 float  World::m_relocation_lower_limit_sq     = 10.f * 10.f;
 uint32 World::m_relocation_ai_notify_delay    = 1000u;
+uint32 World::m_relocation_visibility_interval = 0;
 
 /// World constructor
 World::World()
@@ -585,6 +587,7 @@ void World::LoadConfigSettings(bool reload)
 
     ///- Read other configuration items from the config file
     setConfigMinMax(CONFIG_UINT32_COMPRESSION, "Compression", 1, 1, 9);
+    setConfig(CONFIG_UINT32_COMPRESSION_THRESHOLD, "Compression.Threshold", 0);
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
@@ -600,6 +603,12 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr.SetMapUpdateInterval(getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
 
+    if (configNoReload(reload, CONFIG_UINT32_MAP_UPDATE_THREADS, "MapUpdate.Threads", 0))
+        setConfigMinMax(CONFIG_UINT32_MAP_UPDATE_THREADS, "MapUpdate.Threads", 0, 0, 64);
+
+    if (configNoReload(reload, CONFIG_UINT32_WORLD_LOAD_THREADS, "WorldLoad.Threads", 0))
+        setConfigMinMax(CONFIG_UINT32_WORLD_LOAD_THREADS, "WorldLoad.Threads", 0, 0, 64);
+
     setConfig(CONFIG_UINT32_INTERVAL_CHANGEWEATHER, "ChangeWeatherInterval", 10 * MINUTE * IN_MILLISECONDS);
 
     if (configNoReload(reload, CONFIG_UINT32_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT))
@@ -708,6 +717,13 @@ void World::LoadConfigSettings(bool reload)
         m_timers[WUPDATE_UPTIME].Reset();
     }
 
+    setConfig(CONFIG_UINT32_DB_PROFILE_LOG_INTERVAL, "DatabaseProfileLogInterval", 0);
+    if (reload)
+    {
+        m_timers[WUPDATE_DBPROFILE].SetInterval(getConfig(CONFIG_UINT32_DB_PROFILE_LOG_INTERVAL)*MINUTE * IN_MILLISECONDS);
+        m_timers[WUPDATE_DBPROFILE].Reset();
+    }
+
     setConfig(CONFIG_UINT32_SKILL_CHANCE_ORANGE, "SkillChance.Orange", 100);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_YELLOW, "SkillChance.Yellow", 75);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_GREEN,  "SkillChance.Green",  25);
@@ -820,6 +836,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_OFFHAND_CHECK_AT_TALENTS_RESET, "OffhandCheckAtTalentsReset", false);
 
     setConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET, "Network.KickOnBadPacket", false);
+    setConfigMin(CONFIG_UINT32_SESSION_RECV_QUEUE_SIZE, "Network.RecvQueueSize", 1024, 64);
 
     setConfig(CONFIG_BOOL_PLAYER_COMMANDS, "PlayerCommands", true);
 
@@ -853,6 +870,7 @@ void World::LoadConfigSettings(bool reload)
 
     m_relocation_ai_notify_delay = sConfig.GetIntDefault("Visibility.AIRelocationNotifyDelay", 1000u);
     m_relocation_lower_limit_sq  = pow(sConfig.GetFloatDefault("Visibility.RelocationLowerLimit", 10), 2);
+    m_relocation_visibility_interval = sConfig.GetIntDefault("Visibility.RelocationUpdateInterval", 0);
 
     m_VisibleUnitGreyDistance = sConfig.GetFloatDefault("Visibility.Distance.Grey.Unit", 1);
     if (m_VisibleUnitGreyDistance >  MAX_VISIBILITY_DISTANCE)
@@ -1060,287 +1078,205 @@ void World::SetInitialWorldSettings()
     sObjectMgr.SetHighestGuids();                           // must be after PackInstances() and PackGroupIds()
     sLog.outString();
 
-    sLog.outString("Loading Page Texts...");
-    sObjectMgr.LoadPageTexts();
-
-    sLog.outString("Loading Game Object Templates...");     // must be after LoadPageTexts
-    sObjectMgr.LoadGameobjectInfo();
-
-    sLog.outString("Loading GameObject models...");
-    LoadGameObjectModelList();
-    sLog.outString();
-
-    sLog.outString("Loading Spell Chain Data...");
-    sSpellMgr.LoadSpellChains();
-
-    sLog.outString("Loading Spell Elixir types...");
-    sSpellMgr.LoadSpellElixirs();
-
-    sLog.outString("Loading Spell Learn Skills...");
-    sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Learn Spells...");
-    sSpellMgr.LoadSpellLearnSpells();
-
-    sLog.outString("Loading Spell Proc Event conditions...");
-    sSpellMgr.LoadSpellProcEvents();
-
-    sLog.outString("Loading Spell Bonus Data...");
-    sSpellMgr.LoadSpellBonuses();                           // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Proc Item Enchant...");
-    sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
-
-    sLog.outString("Loading Aggro Spells Definitions...");
-    sSpellMgr.LoadSpellThreats();
-
-    sLog.outString("Loading NPC Texts...");
-    sObjectMgr.LoadGossipText();
-
-    sLog.outString("Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
-
-    sLog.outString("Loading Item Templates...");            // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr.LoadItemPrototypes();
-
-    sLog.outString("Loading Item converts...");             // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemConverts();
-
-    sLog.outString("Loading Item expire converts...");      // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemExpireConverts();
-
-    sLog.outString("Loading Creature Model Based Info Data...");
-    sObjectMgr.LoadCreatureModelInfo();
-
-    sLog.outString("Loading Equipment templates...");
-    sObjectMgr.LoadEquipmentTemplates();
-
-    sLog.outString("Loading Creature Stats...");
-    sObjectMgr.LoadCreatureClassLvlStats();
-
-    sLog.outString("Loading Creature templates...");
-    sObjectMgr.LoadCreatureTemplates();
-
-    sLog.outString("Loading Creature template spells...");
-    sObjectMgr.LoadCreatureTemplateSpells();
-
-    sLog.outString("Loading Creature Model for race...");   // must be after creature templates
-    sObjectMgr.LoadCreatureModelRace();
-
-    sLog.outString("Loading SpellsScriptTarget...");
-    sSpellMgr.LoadSpellScriptTarget();                      // must be after LoadCreatureTemplates and LoadGameobjectInfo
-
-    sLog.outString("Loading Vehicle Accessory...");         // must be after LoadCreatureTemplates
-    sObjectMgr.LoadVehicleAccessory();
-
-    sLog.outString("Loading ItemRequiredTarget...");
-    sObjectMgr.LoadItemRequiredTarget();
-
-    sLog.outString("Loading Reputation Reward Rates...");
-    sObjectMgr.LoadReputationRewardRate();
-
-    sLog.outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr.LoadReputationOnKill();
-
-    sLog.outString("Loading Reputation Spillover Data...");
-    sObjectMgr.LoadReputationSpilloverTemplate();
-
-    sLog.outString("Loading Points Of Interest Data...");
-    sObjectMgr.LoadPointsOfInterest();
-
-    sLog.outString("Loading Creature Data...");
-    sObjectMgr.LoadCreatures();
-
-    sLog.outString("Loading pet levelup spells...");
-    sSpellMgr.LoadPetLevelupSpellMap();
-
-    sLog.outString("Loading pet default spell additional to levelup spells...");
-    sSpellMgr.LoadPetDefaultSpells();
-
-    sLog.outString("Loading Creature Addon Data...");
-    sObjectMgr.LoadCreatureAddons();                        // must be after LoadCreatureTemplates() and LoadCreatures()
-    sLog.outString(">>> Creature Addon Data loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Gameobject Data...");
-    sObjectMgr.LoadGameObjects();
-
-    sLog.outString("Loading Gameobject Addon Data...");
-    sObjectMgr.LoadGameObjectAddon();
-
-    sLog.outString("Loading CreatureLinking Data...");      // must be after Creatures
-    sCreatureLinkingMgr.LoadFromDB();
-
-    sLog.outString("Loading Objects Pooling Data...");
-    sPoolMgr.LoadFromDB();
-
-    sLog.outString("Loading Weather Data...");
-    sObjectMgr.LoadWeatherZoneChances();
-
-    sLog.outString("Loading Quests...");
-    sObjectMgr.LoadQuests();                                // must be loaded after DBCs, creature_template, item_template, gameobject tables
-
-    sLog.outString("Loading Quest POI");
-    sObjectMgr.LoadQuestPOI();
-
-    sLog.outString("Loading Quest Phase Maps...");
-    sObjectMgr.LoadQuestPhaseMaps();
-
-    sLog.outString("Loading Quests Relations...");
-    sObjectMgr.LoadQuestRelations();                        // must be after quest load
-    sLog.outString(">>> Quests Relations loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Game Event Data...");           // must be after sPoolMgr.LoadFromDB and quests to properly load pool events and quests for events
-    sGameEventMgr.LoadFromDB();
-    sLog.outString(">>> Game Event Data loaded");
-    sLog.outString();
-
-    // Load Conditions
-    sLog.outString("Loading Conditions...");
-    sObjectMgr.LoadConditions();
-
-    sLog.outString("Creating map persistent states for non-instanceable maps...");     // must be after PackInstances(), LoadCreatures(), sPoolMgr.LoadFromDB(), sGameEventMgr.LoadFromDB();
-    sMapPersistentStateMgr.InitWorldMaps();
-    sLog.outString();
-
-    sLog.outString("Loading Creature Respawn Data...");     // must be after LoadCreatures(), and sMapPersistentStateMgr.InitWorldMaps()
-    sMapPersistentStateMgr.LoadCreatureRespawnTimes();
-
-    sLog.outString("Loading Gameobject Respawn Data...");   // must be after LoadGameObjects(), and sMapPersistentStateMgr.InitWorldMaps()
-    sMapPersistentStateMgr.LoadGameobjectRespawnTimes();
-
-    sLog.outString("Loading UNIT_NPC_FLAG_SPELLCLICK Data...");
-    sObjectMgr.LoadNPCSpellClickSpells();
-
-    sLog.outString("Loading SpellArea Data...");            // must be after quest load
-    sSpellMgr.LoadSpellAreas();
-
-    sLog.outString("Loading AreaTrigger definitions...");
-    sObjectMgr.LoadAreaTriggerTeleports();                  // must be after item template load
-
-    sLog.outString("Loading Quest Area Triggers...");
-    sObjectMgr.LoadQuestAreaTriggers();                     // must be after LoadQuests
-
-    sLog.outString("Loading Tavern Area Triggers...");
-    sObjectMgr.LoadTavernAreaTriggers();
-
-    sLog.outString("Loading AreaTrigger script names...");
-    sScriptMgr.LoadAreaTriggerScripts();
-
-    sLog.outString("Loading event id script names...");
-    sScriptMgr.LoadEventIdScripts();
-
-    sLog.outString("Loading Graveyard-zone links...");
-    sObjectMgr.LoadGraveyardZones();
-
-    sLog.outString("Loading spell target destination coordinates...");
-    sSpellMgr.LoadSpellTargetPositions();
-
-    sLog.outString("Loading spell pet auras...");
-    sSpellMgr.LoadSpellPetAuras();
-
-    sLog.outString("Loading Player Create Info & Level Stats...");
-    sObjectMgr.LoadPlayerInfo();
-    sLog.outString(">>> Player Create Info & Level Stats loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Exploration BaseXP Data...");
-    sObjectMgr.LoadExplorationBaseXP();
-
-    sLog.outString("Loading Pet Name Parts...");
-    sObjectMgr.LoadPetNames();
-
-    CharacterDatabaseCleaner::CleanDatabase();
-    sLog.outString();
-
-    sLog.outString("Loading the max pet number...");
-    sObjectMgr.LoadPetNumber();
-
-    sLog.outString("Loading pet level stats...");
-    sObjectMgr.LoadPetLevelInfo();
-
-    sLog.outString("Loading Player Corpses...");
-    sObjectMgr.LoadCorpses();
-
-    sLog.outString("Loading Player level dependent mail rewards...");
-    sObjectMgr.LoadMailLevelRewards();
-
-    sLog.outString("Loading Loot Tables...");
-    LoadLootTables();
-    sLog.outString(">>> Loot Tables loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    sLog.outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    sLog.outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr.LoadFishingBaseSkillLevel();
-
-    sLog.outString("Loading Achievements...");
-    sAchievementMgr.LoadAchievementReferenceList();
-    sAchievementMgr.LoadAchievementCriteriaList();
-    sAchievementMgr.LoadAchievementCriteriaRequirements();
-    sAchievementMgr.LoadRewards();
-    sAchievementMgr.LoadRewardLocales();
-    sAchievementMgr.LoadCompletedAchievements();
-    sLog.outString(">>> Achievements loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Instance encounters data...");  // must be after Creature loading
-    sObjectMgr.LoadInstanceEncounters();
-
-    sLog.outString("Loading Npc Text Id...");
-    sObjectMgr.LoadNpcGossips();                            // must be after load Creature and LoadGossipText
-
-    sLog.outString("Loading Gossip scripts...");
-    sScriptMgr.LoadGossipScripts();                         // must be before gossip menu options
-
-    sObjectMgr.LoadGossipMenus();
-
-    sLog.outString("Loading Vendors...");
-    sObjectMgr.LoadVendorTemplates();                       // must be after load ItemTemplate
-    sObjectMgr.LoadVendors();                               // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
-
-    sLog.outString("Loading Trainers...");
-    sObjectMgr.LoadTrainerTemplates();                      // must be after load CreatureTemplate
-    sObjectMgr.LoadTrainers();                              // must be after load CreatureTemplate, TrainerTemplate
-
-    sLog.outString("Loading Waypoint scripts...");          // before loading from creature_movement
-    sScriptMgr.LoadCreatureMovementScripts();
-
-    sLog.outString("Loading Waypoints...");
-    sWaypointMgr.Load();
-
-    sLog.outString("Loading ReservedNames...");
-    sObjectMgr.LoadReservedPlayersNames();
-
-    sLog.outString("Loading GameObjects for quests...");
-    sObjectMgr.LoadGameObjectForQuests();
-
-    sLog.outString("Loading BattleMasters...");
-    sBattleGroundMgr.LoadBattleMastersEntry();
-
-    sLog.outString("Loading BattleGround event indexes...");
-    sBattleGroundMgr.LoadBattleEventIndexes();
-
-    sLog.outString("Loading GameTeleports...");
-    sObjectMgr.LoadGameTele();
-
-    ///- Loading localization data
-    sLog.outString("Loading Localization strings...");
-    sObjectMgr.LoadCreatureLocales();                       // must be after CreatureInfo loading
-    sObjectMgr.LoadGameObjectLocales();                     // must be after GameobjectInfo loading
-    sObjectMgr.LoadItemLocales();                           // must be after ItemPrototypes loading
-    sObjectMgr.LoadQuestLocales();                          // must be after QuestTemplates loading
-    sObjectMgr.LoadGossipTextLocales();                     // must be after LoadGossipText
-    sObjectMgr.LoadPageTextLocales();                       // must be after PageText loading
-    sObjectMgr.LoadGossipMenuItemsLocales();                // must be after gossip menu items loading
-    sObjectMgr.LoadPointOfInterestLocales();                // must be after POI loading
-    sLog.outString(">>> Localization strings loaded");
+    ///- Load the world DB tables, independent loaders run in parallel (see WorldLoad.Threads)
+    WorldLoader loader;
+
+    WorldLoader::TaskId pageTexts = loader.Add("Page Texts", sObjectMgr, &ObjectMgr::LoadPageTexts);
+    WorldLoader::TaskId goInfo = loader.Add("Game Object Templates", sObjectMgr, &ObjectMgr::LoadGameobjectInfo);
+    loader.After(goInfo, pageTexts);
+    loader.Add("GameObject models", &LoadGameObjectModelList);
+
+    WorldLoader::TaskId spellChains = loader.Add("Spell Chain Data", sSpellMgr, &SpellMgr::LoadSpellChains);
+    loader.Add("Spell Elixir types", sSpellMgr, &SpellMgr::LoadSpellElixirs);
+    WorldLoader::TaskId learnSkills = loader.Add("Spell Learn Skills", sSpellMgr, &SpellMgr::LoadSpellLearnSkills);
+    loader.After(learnSkills, spellChains);
+    WorldLoader::TaskId learnSpells = loader.Add("Spell Learn Spells", sSpellMgr, &SpellMgr::LoadSpellLearnSpells);
+    loader.After(learnSpells, spellChains);
+    WorldLoader::TaskId procEvents = loader.Add("Spell Proc Event conditions", sSpellMgr, &SpellMgr::LoadSpellProcEvents);
+    loader.After(procEvents, spellChains);
+    WorldLoader::TaskId spellBonuses = loader.Add("Spell Bonus Data", sSpellMgr, &SpellMgr::LoadSpellBonuses);
+    loader.After(spellBonuses, spellChains);
+    WorldLoader::TaskId procItemEnchant = loader.Add("Spell Proc Item Enchant", sSpellMgr, &SpellMgr::LoadSpellProcItemEnchant);
+    loader.After(procItemEnchant, spellChains);
+    WorldLoader::TaskId threats = loader.Add("Aggro Spells Definitions", sSpellMgr, &SpellMgr::LoadSpellThreats);
+    loader.After(threats, spellChains);
+
+    WorldLoader::TaskId gossipText = loader.Add("NPC Texts", sObjectMgr, &ObjectMgr::LoadGossipText);
+    WorldLoader::TaskId randomEnchants = loader.Add("Item Random Enchantments Table", &LoadRandomEnchantmentsTable);
+    WorldLoader::TaskId items = loader.Add("Item Templates", sObjectMgr, &ObjectMgr::LoadItemPrototypes);
+    loader.After(items, randomEnchants, pageTexts);
+    WorldLoader::TaskId itemConverts = loader.Add("Item converts", sObjectMgr, &ObjectMgr::LoadItemConverts);
+    loader.After(itemConverts, items);
+    WorldLoader::TaskId itemExpireConverts = loader.Add("Item expire converts", sObjectMgr, &ObjectMgr::LoadItemExpireConverts);
+    loader.After(itemExpireConverts, items);
+
+    WorldLoader::TaskId modelInfo = loader.Add("Creature Model Based Info Data", sObjectMgr, &ObjectMgr::LoadCreatureModelInfo);
+    WorldLoader::TaskId equipment = loader.Add("Equipment templates", sObjectMgr, &ObjectMgr::LoadEquipmentTemplates);
+    loader.After(equipment, items);
+    WorldLoader::TaskId classLvlStats = loader.Add("Creature Stats", sObjectMgr, &ObjectMgr::LoadCreatureClassLvlStats);
+    WorldLoader::TaskId creatureTemplates = loader.Add("Creature templates", sObjectMgr, &ObjectMgr::LoadCreatureTemplates);
+    loader.After(creatureTemplates, modelInfo, equipment, classLvlStats);
+    WorldLoader::TaskId templateSpells = loader.Add("Creature template spells", sObjectMgr, &ObjectMgr::LoadCreatureTemplateSpells);
+    loader.After(templateSpells, creatureTemplates);
+    WorldLoader::TaskId modelRace = loader.Add("Creature Model for race", sObjectMgr, &ObjectMgr::LoadCreatureModelRace);
+    loader.After(modelRace, creatureTemplates);
+    WorldLoader::TaskId scriptTarget = loader.Add("SpellsScriptTarget", sSpellMgr, &SpellMgr::LoadSpellScriptTarget);
+    loader.After(scriptTarget, creatureTemplates, goInfo);
+    WorldLoader::TaskId vehicleAccessory = loader.Add("Vehicle Accessory", sObjectMgr, &ObjectMgr::LoadVehicleAccessory);
+    loader.After(vehicleAccessory, creatureTemplates);
+    WorldLoader::TaskId itemRequiredTarget = loader.Add("ItemRequiredTarget", sObjectMgr, &ObjectMgr::LoadItemRequiredTarget);
+    loader.After(itemRequiredTarget, items, creatureTemplates, scriptTarget);
+    loader.Add("Reputation Reward Rates", sObjectMgr, &ObjectMgr::LoadReputationRewardRate);
+    WorldLoader::TaskId reputationOnKill = loader.Add("Creature Reputation OnKill Data", sObjectMgr, &ObjectMgr::LoadReputationOnKill);
+    loader.After(reputationOnKill, creatureTemplates);
+    loader.Add("Reputation Spillover Data", sObjectMgr, &ObjectMgr::LoadReputationSpilloverTemplate);
+    WorldLoader::TaskId pointsOfInterest = loader.Add("Points Of Interest Data", sObjectMgr, &ObjectMgr::LoadPointsOfInterest);
+
+    // creature and gameobject spawns share the grid guid maps, keep them in one chain
+    WorldLoader::TaskId creatures = loader.Add("Creature Data", sObjectMgr, &ObjectMgr::LoadCreatures);
+    loader.After(creatures, creatureTemplates);
+    loader.Add("pet levelup spells", sSpellMgr, &SpellMgr::LoadPetLevelupSpellMap);
+    WorldLoader::TaskId petDefaultSpells = loader.Add("pet default spell additional to levelup spells", sSpellMgr, &SpellMgr::LoadPetDefaultSpells);
+    loader.After(petDefaultSpells, templateSpells);
+    WorldLoader::TaskId creatureAddons = loader.Add("Creature Addon Data", sObjectMgr, &ObjectMgr::LoadCreatureAddons);
+    loader.After(creatureAddons, creatures);
+    WorldLoader::TaskId gameobjects = loader.Add("Gameobject Data", sObjectMgr, &ObjectMgr::LoadGameObjects);
+    loader.After(gameobjects, goInfo, creatures);
+    WorldLoader::TaskId gameobjectAddons = loader.Add("Gameobject Addon Data", sObjectMgr, &ObjectMgr::LoadGameObjectAddon);
+    loader.After(gameobjectAddons, gameobjects);
+    WorldLoader::TaskId creatureLinking = loader.Add("CreatureLinking Data", sCreatureLinkingMgr, &CreatureLinkingMgr::LoadFromDB);
+    loader.After(creatureLinking, creatures);
+    WorldLoader::TaskId pools = loader.Add("Objects Pooling Data", sPoolMgr, &PoolManager::LoadFromDB);
+    loader.After(pools, creatures, gameobjects, creatureLinking);
+    loader.Add("Weather Data", sObjectMgr, &ObjectMgr::LoadWeatherZoneChances);
+
+    WorldLoader::TaskId quests = loader.Add("Quests", sObjectMgr, &ObjectMgr::LoadQuests);
+    loader.After(quests, items, creatureTemplates, goInfo, spellChains);
+    WorldLoader::TaskId questPOI = loader.Add("Quest POI", sObjectMgr, &ObjectMgr::LoadQuestPOI);
+    loader.After(questPOI, quests);
+    WorldLoader::TaskId questPhaseMaps = loader.Add("Quest Phase Maps", sObjectMgr, &ObjectMgr::LoadQuestPhaseMaps);
+    loader.After(questPhaseMaps, quests);
+    WorldLoader::TaskId questRelations = loader.Add("Quests Relations", sObjectMgr, &ObjectMgr::LoadQuestRelations);
+    loader.After(questRelations, quests);
+    WorldLoader::TaskId gameEvents = loader.Add("Game Event Data", sGameEventMgr, &GameEventMgr::LoadFromDB);
+    loader.After(gameEvents, pools, questRelations, gameobjectAddons, creatureAddons);
+
+    WorldLoader::TaskId conditions = loader.Add("Conditions", sObjectMgr, &ObjectMgr::LoadConditions);
+    loader.After(conditions, gameEvents);
+
+    WorldLoader::TaskId worldMaps = loader.Add("map persistent states for non-instanceable maps", sMapPersistentStateMgr, &MapPersistentStateManager::InitWorldMaps);
+    loader.After(worldMaps, gameEvents);
+    WorldLoader::TaskId creatureRespawns = loader.Add("Creature Respawn Data", sMapPersistentStateMgr, &MapPersistentStateManager::LoadCreatureRespawnTimes);
+    loader.After(creatureRespawns, worldMaps);
+    WorldLoader::TaskId gameobjectRespawns = loader.Add("Gameobject Respawn Data", sMapPersistentStateMgr, &MapPersistentStateManager::LoadGameobjectRespawnTimes);
+    loader.After(gameobjectRespawns, creatureRespawns);
+
+    WorldLoader::TaskId spellClick = loader.Add("UNIT_NPC_FLAG_SPELLCLICK Data", sObjectMgr, &ObjectMgr::LoadNPCSpellClickSpells);
+    loader.After(spellClick, creatureTemplates, conditions);
+    WorldLoader::TaskId spellAreas = loader.Add("SpellArea Data", sSpellMgr, &SpellMgr::LoadSpellAreas);
+    loader.After(spellAreas, quests, conditions);
+    WorldLoader::TaskId areaTriggerTeleports = loader.Add("AreaTrigger definitions", sObjectMgr, &ObjectMgr::LoadAreaTriggerTeleports);
+    loader.After(areaTriggerTeleports, items, quests);
+    WorldLoader::TaskId questAreaTriggers = loader.Add("Quest Area Triggers", sObjectMgr, &ObjectMgr::LoadQuestAreaTriggers);
+    loader.After(questAreaTriggers, quests);
+    loader.Add("Tavern Area Triggers", sObjectMgr, &ObjectMgr::LoadTavernAreaTriggers);
+
+    // script loaders check creature, gameobject and quest references, keep them in one chain
+    WorldLoader::TaskId areaTriggerScripts = loader.Add("AreaTrigger script names", sScriptMgr, &ScriptMgr::LoadAreaTriggerScripts);
+    WorldLoader::TaskId eventIdScripts = loader.Add("event id script names", sScriptMgr, &ScriptMgr::LoadEventIdScripts);
+    loader.After(eventIdScripts, areaTriggerScripts, goInfo);
+
+    loader.Add("Graveyard-zone links", sObjectMgr, &ObjectMgr::LoadGraveyardZones);
+    loader.Add("spell target destination coordinates", sSpellMgr, &SpellMgr::LoadSpellTargetPositions);
+    WorldLoader::TaskId petAuras = loader.Add("spell pet auras", sSpellMgr, &SpellMgr::LoadSpellPetAuras);
+    loader.After(petAuras, creatureTemplates);
+    WorldLoader::TaskId playerInfo = loader.Add("Player Create Info & Level Stats", sObjectMgr, &ObjectMgr::LoadPlayerInfo);
+    loader.After(playerInfo, items);
+    loader.Add("Exploration BaseXP Data", sObjectMgr, &ObjectMgr::LoadExplorationBaseXP);
+    loader.Add("Pet Name Parts", sObjectMgr, &ObjectMgr::LoadPetNames);
+    loader.Add("character database cleanup", &CharacterDatabaseCleaner::CleanDatabase);
+    loader.Add("the max pet number", sObjectMgr, &ObjectMgr::LoadPetNumber);
+    WorldLoader::TaskId petLevelInfo = loader.Add("pet level stats", sObjectMgr, &ObjectMgr::LoadPetLevelInfo);
+    loader.After(petLevelInfo, creatureTemplates);
+    // corpses are added to the grid guid maps and to the map persistent states
+    WorldLoader::TaskId corpses = loader.Add("Player Corpses", sObjectMgr, &ObjectMgr::LoadCorpses);
+    loader.After(corpses, gameobjectRespawns);
+    WorldLoader::TaskId mailLevelRewards = loader.Add("Player level dependent mail rewards", sObjectMgr, &ObjectMgr::LoadMailLevelRewards);
+    loader.After(mailLevelRewards, creatureTemplates);
+
+    WorldLoader::TaskId loot = loader.Add("Loot Tables", &LoadLootTables);
+    loader.After(loot, items, creatureTemplates, goInfo, conditions);
+    WorldLoader::TaskId skillDiscovery = loader.Add("Skill Discovery Table", &LoadSkillDiscoveryTable);
+    loader.After(skillDiscovery, spellChains);
+    loader.Add("Skill Extra Item Table", &LoadSkillExtraItemTable);
+    loader.Add("Skill Fishing base level requirements", sObjectMgr, &ObjectMgr::LoadFishingBaseSkillLevel);
+
+    WorldLoader::TaskId achievementReferences = loader.Add("Achievement references", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementReferenceList);
+    WorldLoader::TaskId achievementCriteria = loader.Add("Achievement criteria", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementCriteriaList);
+    loader.After(achievementCriteria, achievementReferences);
+    WorldLoader::TaskId achievementRequirements = loader.Add("Achievement criteria requirements", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementCriteriaRequirements);
+    loader.After(achievementRequirements, achievementCriteria, conditions);
+    WorldLoader::TaskId achievementRewards = loader.Add("Achievement rewards", sAchievementMgr, &AchievementGlobalMgr::LoadRewards);
+    loader.After(achievementRewards, achievementRequirements);
+    WorldLoader::TaskId completedAchievements = loader.Add("Completed achievements", sAchievementMgr, &AchievementGlobalMgr::LoadCompletedAchievements);
+    loader.After(completedAchievements, achievementRewards);
+
+    WorldLoader::TaskId instanceEncounters = loader.Add("Instance encounters data", sObjectMgr, &ObjectMgr::LoadInstanceEncounters);
+    loader.After(instanceEncounters, creatures);
+    WorldLoader::TaskId npcGossips = loader.Add("Npc Text Id", sObjectMgr, &ObjectMgr::LoadNpcGossips);
+    loader.After(npcGossips, creatures, gossipText);
+    WorldLoader::TaskId gossipScripts = loader.Add("Gossip scripts", sScriptMgr, &ScriptMgr::LoadGossipScripts);
+    loader.After(gossipScripts, eventIdScripts, conditions, corpses, questAreaTriggers);
+    WorldLoader::TaskId gossipMenus = loader.Add("Gossip menus", sObjectMgr, &ObjectMgr::LoadGossipMenus);
+    loader.After(gossipMenus, gossipScripts, gossipText, pointsOfInterest, npcGossips);
+
+    WorldLoader::TaskId vendorTemplates = loader.Add("Vendor templates", sObjectMgr, &ObjectMgr::LoadVendorTemplates);
+    loader.After(vendorTemplates, items, conditions);
+    WorldLoader::TaskId vendors = loader.Add("Vendors", sObjectMgr, &ObjectMgr::LoadVendors);
+    loader.After(vendors, vendorTemplates, creatureTemplates);
+    WorldLoader::TaskId trainerTemplates = loader.Add("Trainer templates", sObjectMgr, &ObjectMgr::LoadTrainerTemplates);
+    loader.After(trainerTemplates, creatureTemplates, learnSkills, learnSpells);
+    WorldLoader::TaskId trainers = loader.Add("Trainers", sObjectMgr, &ObjectMgr::LoadTrainers);
+    loader.After(trainers, trainerTemplates);
+
+    WorldLoader::TaskId movementScripts = loader.Add("Waypoint scripts", sScriptMgr, &ScriptMgr::LoadCreatureMovementScripts);
+    loader.After(movementScripts, gossipScripts);
+    WorldLoader::TaskId waypoints = loader.Add("Waypoints", sWaypointMgr, &WaypointManager::Load);
+    loader.After(waypoints, movementScripts, creatures);
+
+    loader.Add("ReservedNames", sObjectMgr, &ObjectMgr::LoadReservedPlayersNames);
+    WorldLoader::TaskId gameobjectForQuests = loader.Add("GameObjects for quests", sObjectMgr, &ObjectMgr::LoadGameObjectForQuests);
+    loader.After(gameobjectForQuests, goInfo, questRelations, loot);
+    WorldLoader::TaskId battleMasters = loader.Add("BattleMasters", sBattleGroundMgr, &BattleGroundMgr::LoadBattleMastersEntry);
+    loader.After(battleMasters, creatureTemplates);
+    WorldLoader::TaskId battleEvents = loader.Add("BattleGround event indexes", sBattleGroundMgr, &BattleGroundMgr::LoadBattleEventIndexes);
+    loader.After(battleEvents, battleMasters, creatures, gameobjects);
+    loader.Add("GameTeleports", sObjectMgr, &ObjectMgr::LoadGameTele);
+
+    // all locale loaders add to the same locale index table, so they run one after another
+    WorldLoader::TaskId creatureLocales = loader.Add("Creature locales", sObjectMgr, &ObjectMgr::LoadCreatureLocales);
+    loader.After(creatureLocales, creatureTemplates);
+    WorldLoader::TaskId gameobjectLocales = loader.Add("GameObject locales", sObjectMgr, &ObjectMgr::LoadGameObjectLocales);
+    loader.After(gameobjectLocales, creatureLocales, goInfo);
+    WorldLoader::TaskId itemLocales = loader.Add("Item locales", sObjectMgr, &ObjectMgr::LoadItemLocales);
+    loader.After(itemLocales, gameobjectLocales, items);
+    WorldLoader::TaskId questLocales = loader.Add("Quest locales", sObjectMgr, &ObjectMgr::LoadQuestLocales);
+    loader.After(questLocales, itemLocales, quests);
+    WorldLoader::TaskId gossipTextLocales = loader.Add("NPC Text locales", sObjectMgr, &ObjectMgr::LoadGossipTextLocales);
+    loader.After(gossipTextLocales, questLocales, gossipText);
+    WorldLoader::TaskId pageTextLocales = loader.Add("Page Text locales", sObjectMgr, &ObjectMgr::LoadPageTextLocales);
+    loader.After(pageTextLocales, gossipTextLocales, pageTexts);
+    WorldLoader::TaskId gossipMenuLocales = loader.Add("Gossip menu option locales", sObjectMgr, &ObjectMgr::LoadGossipMenuItemsLocales);
+    loader.After(gossipMenuLocales, pageTextLocales, gossipMenus);
+    WorldLoader::TaskId poiLocales = loader.Add("Points Of Interest locales", sObjectMgr, &ObjectMgr::LoadPointOfInterestLocales);
+    loader.After(poiLocales, gossipMenuLocales, pointsOfInterest);
+    WorldLoader::TaskId achievementRewardLocales = loader.Add("Achievement reward locales", sAchievementMgr, &AchievementGlobalMgr::LoadRewardLocales);
+    loader.After(achievementRewardLocales, poiLocales, achievementRewards);
+
+    loader.Run(getConfig(CONFIG_UINT32_WORLD_LOAD_THREADS));
+    loader.LogTimings();
+
+    sLog.outString("Peak memory usage after loading world tables: " UI64FMTD " kB", GetPeakMemoryUsage());
     sLog.outString();
 
     ///- Load dynamic data tables from the database
@@ -1436,6 +1372,7 @@ void World::SetInitialWorldSettings()
     // Update "uptime" table based on configuration entry in minutes.
     m_timers[WUPDATE_CORPSES].SetInterval(20 * MINUTE * IN_MILLISECONDS);
     m_timers[WUPDATE_DELETECHARS].SetInterval(DAY * IN_MILLISECONDS); // check for chars to delete every day
+    m_timers[WUPDATE_DBPROFILE].SetInterval(getConfig(CONFIG_UINT32_DB_PROFILE_LOG_INTERVAL)*MINUTE * IN_MILLISECONDS);
 
     // for AhBot
     m_timers[WUPDATE_AHBOT].SetInterval(20 * IN_MILLISECONDS); // every 20 sec
@@ -1507,6 +1444,7 @@ void World::SetInitialWorldSettings()
 
     uint32 uStartInterval = WorldTimer::getMSTimeDiff(uStartTime, WorldTimer::getMSTime());
     sLog.outString("SERVER STARTUP TIME: %i minutes %i seconds", uStartInterval / 60000, (uStartInterval % 60000) / 1000);
+    sLog.outString("SERVER STARTUP PEAK MEMORY: " UI64FMTD " kB", GetPeakMemoryUsage());
     sLog.outString();
 }
 
@@ -1646,6 +1584,20 @@ void World::Update(uint32 diff)
         LoginDatabase.PExecute("UPDATE uptime SET uptime = %u, maxplayers = %u WHERE realmid = %u AND starttime = " UI64FMTD, tmpDiff, maxClientsNum, realmID, uint64(m_startTime));
     }
 
+    /// <li> Log the most expensive async database statements of the last period
+    if (getConfig(CONFIG_UINT32_DB_PROFILE_LOG_INTERVAL) && m_timers[WUPDATE_DBPROFILE].Passed())
+    {
+        m_timers[WUPDATE_DBPROFILE].Reset();
+
+        WorldDatabase.LogOperationProfile("World", 10);
+        CharacterDatabase.LogOperationProfile("Character", 10);
+        LoginDatabase.LogOperationProfile("Login", 10);
+
+        WorldDatabase.ResetOperationProfile();
+        CharacterDatabase.ResetOperationProfile();
+        LoginDatabase.ResetOperationProfile();
+    }
+
     /// <li> Handle all other objects
     ///- Update objects (maps, transport, creatures,...)
     sMapMgr.Update(diff);
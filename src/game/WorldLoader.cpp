@@ -0,0 +1,227 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "WorldLoader.h"
+#include "Log.h"
+#include "Timer.h"
+#include "ProgressBar.h"
+#include "Database/DatabaseEnv.h"
+
+#include <algorithm>
+
+namespace
+{
+    // task for loaders that are free functions
+    class WorldLoaderFunction : public MaNGOS::ICallback
+    {
+        public:
+            explicit WorldLoaderFunction(void (*function)()) : m_function(function) {}
+
+            void Execute() override { m_function(); }
+
+        private:
+            void (*m_function)();
+    };
+
+    struct TaskDurationGreater
+    {
+        TaskDurationGreater(std::vector<uint32> const& durations) : m_durations(durations) {}
+
+        bool operator()(uint32 a, uint32 b) const { return m_durations[a] > m_durations[b]; }
+
+        std::vector<uint32> const& m_durations;
+    };
+}
+
+WorldLoader::WorldLoader() :
+    m_finishedTasks(0), m_runStartTime(0), m_runDuration(0), m_threadCount(0), m_condition(m_lock)
+{
+}
+
+WorldLoader::~WorldLoader()
+{
+    for (TaskList::iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+        delete itr->m_callback;
+}
+
+WorldLoader::TaskId WorldLoader::Add(char const* name, void (*function)())
+{
+    return AddTask(name, new WorldLoaderFunction(function));
+}
+
+WorldLoader::TaskId WorldLoader::AddTask(char const* name, MaNGOS::ICallback* callback)
+{
+    m_tasks.push_back(Task(name, callback));
+    return TaskId(m_tasks.size() - 1);
+}
+
+void WorldLoader::After(TaskId task, TaskId dep1, TaskId dep2 /*= NO_TASK*/, TaskId dep3 /*= NO_TASK*/, TaskId dep4 /*= NO_TASK*/, TaskId dep5 /*= NO_TASK*/)
+{
+    AddDependency(task, dep1);
+    AddDependency(task, dep2);
+    AddDependency(task, dep3);
+    AddDependency(task, dep4);
+    AddDependency(task, dep5);
+}
+
+void WorldLoader::AddDependency(TaskId task, TaskId dependsOn)
+{
+    if (dependsOn == NO_TASK)
+        return;
+
+    // only backward edges, so the graph can't have cycles and the add order is a valid run order
+    MANGOS_ASSERT(task < m_tasks.size() && dependsOn < task);
+
+    m_tasks[dependsOn].m_dependents.push_back(task);
+    ++m_tasks[task].m_dependencies;
+}
+
+void WorldLoader::Run(uint32 numThreads)
+{
+    m_readyTasks.clear();
+    m_finishedTasks = 0;
+
+    for (TaskId id = 0; id < m_tasks.size(); ++id)
+    {
+        m_tasks[id].m_pending = m_tasks[id].m_dependencies;
+        if (!m_tasks[id].m_pending)
+            m_readyTasks.insert(id);
+    }
+
+    m_runStartTime = WorldTimer::getMSTime();
+    m_threadCount = 1;
+
+    if (numThreads > 1 && m_tasks.size() > 1)
+    {
+        // progress bars of concurrent loaders would overwrite each other on the console
+        bool showProgress = BarGoLink::GetOutputState();
+        BarGoLink::SetOutputState(false);
+
+        if (activate(THR_NEW_LWP | THR_JOINABLE, int(numThreads)) != -1)
+        {
+            m_threadCount = numThreads;
+            wait();
+        }
+        else
+            sLog.outError("WorldLoader: can't create %u load threads, loading in the world thread", numThreads);
+
+        BarGoLink::SetOutputState(showProgress);
+    }
+
+    if (m_finishedTasks < m_tasks.size())
+    {
+        for (TaskId id = 0; id < m_tasks.size(); ++id)
+            ExecuteTask(id);
+
+        m_finishedTasks = m_tasks.size();
+    }
+
+    m_runDuration = WorldTimer::getMSTimeDiff(m_runStartTime, WorldTimer::getMSTime());
+}
+
+void WorldLoader::ExecuteTask(TaskId id)
+{
+    Task& task = m_tasks[id];
+
+    sLog.outString("Loading %s...", task.m_name.c_str());
+
+    uint32 startTime = WorldTimer::getMSTime();
+    task.m_startTime = WorldTimer::getMSTimeDiff(m_runStartTime, startTime);
+
+    task.m_callback->Execute();
+
+    task.m_duration = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+}
+
+int WorldLoader::svc()
+{
+    // loaders use the query connection pools, size them with the *DatabaseConnections options
+    WorldDatabase.ThreadStart();
+    CharacterDatabase.ThreadStart();
+    LoginDatabase.ThreadStart();
+
+    for (;;)
+    {
+        TaskId id;
+
+        {
+            LOCK_GUARD guard(m_lock);
+
+            while (m_readyTasks.empty() && m_finishedTasks < m_tasks.size())
+                m_condition.wait();
+
+            if (m_readyTasks.empty())
+                break;                                      // all tasks done
+
+            id = *m_readyTasks.begin();
+            m_readyTasks.erase(m_readyTasks.begin());
+        }
+
+        ExecuteTask(id);
+
+        {
+            LOCK_GUARD guard(m_lock);
+
+            std::vector<TaskId> const& dependents = m_tasks[id].m_dependents;
+            for (size_t i = 0; i < dependents.size(); ++i)
+            {
+                if (--m_tasks[dependents[i]].m_pending == 0)
+                    m_readyTasks.insert(dependents[i]);
+            }
+
+            ++m_finishedTasks;
+            m_condition.broadcast();
+        }
+    }
+
+    LoginDatabase.ThreadEnd();
+    CharacterDatabase.ThreadEnd();
+    WorldDatabase.ThreadEnd();
+
+    return 0;
+}
+
+void WorldLoader::LogTimings() const
+{
+    std::vector<uint32> durations(m_tasks.size());
+    std::vector<uint32> order(m_tasks.size());
+    uint32 totalDuration = 0;
+
+    for (TaskId id = 0; id < m_tasks.size(); ++id)
+    {
+        durations[id] = m_tasks[id].m_duration;
+        order[id] = id;
+        totalDuration += m_tasks[id].m_duration;
+    }
+
+    std::stable_sort(order.begin(), order.end(), TaskDurationGreater(durations));
+
+    sLog.outString();
+    sLog.outString("Loaded %u tasks in %u ms with %u thread(s), %u ms spent in tasks:",
+                   uint32(m_tasks.size()), m_runDuration, m_threadCount, totalDuration);
+    sLog.outString("  %-48s %9s %9s", "Task", "Start", "Time");
+
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        Task const& task = m_tasks[order[i]];
+        sLog.outString("  %-48s %6u ms %6u ms", task.m_name.c_str(), task.m_startTime, task.m_duration);
+    }
+
+    sLog.outString();
+}
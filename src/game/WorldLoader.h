@@ -0,0 +1,109 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef MANGOS_WORLDLOADER_H
+#define MANGOS_WORLDLOADER_H
+
+#include "Common.h"
+#include "Platform/Define.h"
+#include "Utilities/Callback.h"
+
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include <set>
+
+/**
+ * Dependency graph of the startup DB loaders.
+ *
+ * Every loader is added as a task, and After() declares which earlier tasks must be
+ * finished before it may start. Run() executes the graph on a pool of worker threads,
+ * every task starts as soon as all its dependencies are done. With a single thread the
+ * tasks run one after another in the calling thread, in the order they were added.
+ *
+ * Tasks only may share data through declared dependencies, anything written by two
+ * tasks (containers, locale index tables, grid guid maps) needs a dependency between them.
+ */
+class WorldLoader : protected ACE_Task_Base
+{
+    public:
+        typedef uint32 TaskId;
+
+        static TaskId const NO_TASK = TaskId(-1);
+
+        WorldLoader();
+        ~WorldLoader();
+
+        template<class T>
+        TaskId Add(char const* name, T& object, void (T::*method)())
+        {
+            return AddTask(name, new MaNGOS::Callback<T>(&object, method));
+        }
+
+        TaskId Add(char const* name, void (*function)());
+
+        // task can start only after all given tasks are done, dependencies must be added before the task
+        void After(TaskId task, TaskId dep1, TaskId dep2 = NO_TASK, TaskId dep3 = NO_TASK, TaskId dep4 = NO_TASK, TaskId dep5 = NO_TASK);
+
+        // execute all tasks and block until they are done
+        void Run(uint32 numThreads);
+
+        // per task timing table of the last Run(), slowest first
+        void LogTimings() const;
+
+    protected:
+        int svc() override;
+
+    private:
+        struct Task
+        {
+            Task(char const* name, MaNGOS::ICallback* callback) :
+                m_name(name), m_callback(callback), m_dependencies(0), m_pending(0), m_startTime(0), m_duration(0) {}
+
+            std::string m_name;
+            MaNGOS::ICallback* m_callback;
+            std::vector<TaskId> m_dependents;               // tasks waiting for this one
+            uint32 m_dependencies;
+            uint32 m_pending;                               // not yet finished dependencies during Run()
+            uint32 m_startTime;                             // ms since start of Run()
+            uint32 m_duration;
+        };
+
+        typedef std::vector<Task> TaskList;
+
+        typedef ACE_Thread_Mutex LOCK_TYPE;
+        typedef ACE_Guard<LOCK_TYPE> LOCK_GUARD;
+
+        TaskId AddTask(char const* name, MaNGOS::ICallback* callback);
+        void AddDependency(TaskId task, TaskId dependsOn);
+        void ExecuteTask(TaskId id);
+
+        TaskList m_tasks;
+        std::set<TaskId> m_readyTasks;                      // lowest id first, keeps the log close to the add order
+        uint32 m_finishedTasks;
+        uint32 m_runStartTime;
+        uint32 m_runDuration;
+        uint32 m_threadCount;
+
+        LOCK_TYPE m_lock;
+        ACE_Condition_Thread_Mutex m_condition;             // signaled when a task finished
+};
+
+#endif
@@ -23,9 +23,11 @@
 #include "WorldSocket.h"                                    // must be first to make ACE happy with ACE includes in it
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/SqlOperations.h"
 #include "Log.h"
 #include "Opcodes.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 #include "WorldSession.h"
 #include "Player.h"
 #include "ObjectMgr.h"
@@ -84,7 +86,8 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     m_muteTime(mute_time), _player(NULL), m_Socket(sock), _security(sec), _accountId(id), m_expansion(expansion), _logoutTime(0),
     m_inQueue(false), m_playerLoading(false), m_playerLogout(false), m_playerRecentlyLogout(false), m_playerSave(false),
     m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetIndexForLocale(locale)),
-    m_latency(0), m_tutorialState(TUTORIALDATA_UNCHANGED)
+    m_latency(0), m_tutorialState(TUTORIALDATA_UNCHANGED),
+    _recvQueue(sWorld.getConfig(CONFIG_UINT32_SESSION_RECV_QUEUE_SIZE)), m_queryResultQueue(new SqlResultQueue)
 {
     if (sock)
     {
@@ -112,6 +115,9 @@ WorldSession::~WorldSession()
     WorldPacket* packet = NULL;
     while (_recvQueue.next(packet))
         delete packet;
+
+    ///- queries still running for this session drop their results
+    m_queryResultQueue->Close();
 }
 
 void WorldSession::SizeError(WorldPacket const& packet, uint32 size) const
@@ -126,23 +132,10 @@ char const* WorldSession::GetPlayerName() const
     return GetPlayer() ? GetPlayer()->GetName() : "<none>";
 }
 
-/// Send a packet to the client
-void WorldSession::SendPacket(WorldPacket const* packet)
-{
-    if (!m_Socket)
-        return;
-
-    if (serverOpcodeTable[packet->GetOpcode()].status == STATUS_UNHANDLED)
-    {
-        sLog.outError("SESSION: tried to send an unhandled opcode 0x%.4X", packet->GetOpcode());
-        return;
-    }
-
-    const_cast<WorldPacket*>(packet)->FlushBits();
-
 #ifdef MANGOS_DEBUG
-
-    // Code for network use statistic
+/// Code for network use statistic, shared by both SendPacket versions
+static void RecordSendStatistics(WorldPacket const* packet)
+{
     static uint64 sendPacketCount = 0;
     static uint64 sendPacketBytes = 0;
 
@@ -173,17 +166,60 @@ void WorldSession::SendPacket(WorldPacket const* packet)
         sendLastPacketCount = 1;
         sendLastPacketBytes = packet->wpos();               // wpos is real written size
     }
-
+}
 #endif                                                  // !MANGOS_DEBUG
 
+/// Send a packet to the client
+void WorldSession::SendPacket(WorldPacket const* packet)
+{
+    if (!m_Socket)
+        return;
+
+    if (serverOpcodeTable[packet->GetOpcode()].status == STATUS_UNHANDLED)
+    {
+        sLog.outError("SESSION: tried to send an unhandled opcode 0x%.4X", packet->GetOpcode());
+        return;
+    }
+
+    const_cast<WorldPacket*>(packet)->FlushBits();
+
+#ifdef MANGOS_DEBUG
+    RecordSendStatistics(packet);
+#endif
+
     if (m_Socket->SendPacket(*packet) == -1)
         m_Socket->CloseSocket();
 }
 
+/// Send a packet that is broadcasted to many clients
+void WorldSession::SendPacket(SharedWorldPacket const& packet)
+{
+    if (!m_Socket)
+        return;
+
+    if (serverOpcodeTable[packet.GetPacket().GetOpcode()].status == STATUS_UNHANDLED)
+    {
+        sLog.outError("SESSION: tried to send an unhandled opcode 0x%.4X", packet.GetPacket().GetOpcode());
+        return;
+    }
+
+#ifdef MANGOS_DEBUG
+    RecordSendStatistics(&packet.GetPacket());
+#endif
+
+    if (m_Socket->SendPacket(packet) == -1)
+        m_Socket->CloseSocket();
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
-    _recvQueue.add(new_packet);
+    if (!_recvQueue.add(new_packet))
+    {
+        DEBUG_LOG("SESSION: receive queue of account %u is full, opcode %s (0x%.4X) dropped",
+                  GetAccountId(), new_packet->GetOpcodeName(), new_packet->GetOpcode());
+        delete new_packet;
+    }
 }
 
 /// Logging helper for unexpected opcodes
@@ -207,6 +243,11 @@ void WorldSession::LogUnprocessedTail(WorldPacket* packet)
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(PacketFilter& updater)
 {
+    ///- Execute the callbacks of finished async queries started by this session
+    /// only in World::UpdateSessions(), map threads may update several sessions at once
+    if (updater.ProcessLogout())
+        m_queryResultQueue->Update();
+
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
     WorldPacket* packet = NULL;
@@ -24,6 +24,7 @@
 #define __WORLDSESSION_H
 
 #include "Common.h"
+#include "LockFreeQueue.h"
 #include "SharedDefines.h"
 #include "ObjectGuid.h"
 #include "AuctionHouseMgr.h"
@@ -41,8 +42,11 @@ class Object;
 class Player;
 class Unit;
 class WorldPacket;
+class SharedWorldPacket;
 class WorldSocket;
 class QueryResult;
+class SqlResultQueue;
+template<class Class> class SqlQueryChain;
 class LoginQueryHolder;
 class CharacterHandler;
 class GMTicket;
@@ -245,6 +249,7 @@ class MANGOS_DLL_SPEC WorldSession
         void SendAddonsInfo();
 
         void SendPacket(WorldPacket const* packet);
+        void SendPacket(SharedWorldPacket const& packet);
         void SendNotification(const char* format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(int32 string_id, ...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName* declinedName);
@@ -291,14 +296,23 @@ class MANGOS_DLL_SPEC WorldSession
 
         void QueuePacket(WorldPacket* new_packet);
 
+        // receive queue statistics
+        uint32 GetRecvQueueSize() const { return uint32(_recvQueue.size()); }
+        uint32 GetRecvQueueCapacity() const { return uint32(_recvQueue.capacity()); }
+        uint32 GetRecvQueuePeak() const { return uint32(_recvQueue.peak()); }
+        uint32 GetRecvQueueDropped() const { return uint32(_recvQueue.dropped()); }
+
         bool Update(PacketFilter& updater);
 
+        // async query callbacks for this session, executed by the Update() from World::UpdateSessions on the world thread
+        SqlResultQueue* GetQueryResultQueue() const { return m_queryResultQueue; }
+
         /// Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQue(uint32 position);
 
         void SendNameQueryOpcode(Player* p);
         void SendNameQueryOpcodeFromDB(ObjectGuid guid);
-        static void SendNameQueryOpcodeFromDBCallBack(QueryResult* result, uint32 accountId);
+        void SendNameQueryOpcodeFromDBCallBack(QueryResult* result);
 
         void SendTrainerList(ObjectGuid guid);
         void SendTrainerList(ObjectGuid guid, const std::string& strTitle);
@@ -483,10 +497,10 @@ class MANGOS_DLL_SPEC WorldSession
         void HandleEmoteOpcode(WorldPacket& recvPacket);
         void HandleContactListOpcode(WorldPacket& recvPacket);
         void HandleAddFriendOpcode(WorldPacket& recvPacket);
-        static void HandleAddFriendOpcodeCallBack(QueryResult* result, uint32 accountId, std::string friendNote);
+        void HandleAddFriendOpcodeCallBack(QueryResult* result, std::string friendNote);
         void HandleDelFriendOpcode(WorldPacket& recvPacket);
         void HandleAddIgnoreOpcode(WorldPacket& recvPacket);
-        static void HandleAddIgnoreOpcodeCallBack(QueryResult* result, uint32 accountId);
+        void HandleAddIgnoreOpcodeCallBack(QueryResult* result);
         void HandleDelIgnoreOpcode(WorldPacket& recvPacket);
         void HandleSetContactNotesOpcode(WorldPacket& recvPacket);
         void HandleBugOpcode(WorldPacket& recvPacket);
@@ -762,7 +776,8 @@ class MANGOS_DLL_SPEC WorldSession
         void HandleSetActionBarTogglesOpcode(WorldPacket& recv_data);
 
         void HandleCharRenameOpcode(WorldPacket& recv_data);
-        static void HandleChangePlayerNameOpcodeCallBack(QueryResult* result, uint32 accountId, std::string newname);
+        void HandleChangePlayerNameOpcodeCallBack(QueryResult* result, SqlQueryChain<WorldSession> chain, uint32 guidLow, std::string newname);
+        void HandleChangePlayerNameOwnerCallBack(QueryResult* result, SqlQueryChain<WorldSession> chain, std::string newname);
         void HandleSetPlayerDeclinedNamesOpcode(WorldPacket& recv_data);
 
         void HandleTotemDestroyed(WorldPacket& recv_data);
@@ -918,7 +933,8 @@ class MANGOS_DLL_SPEC WorldSession
         uint32 m_Tutorials[8];
         TutorialDataState m_tutorialState;
         AddonsList m_addonsList;
-        ACE_Based::LockedQueue<WorldPacket*, ACE_Thread_Mutex> _recvQueue;
+        ACE_Based::LockFreeQueue<WorldPacket*> _recvQueue;  // filled by network threads, emptied by Update()
+        SqlResultQueue* m_queryResultQueue;                 // filled by database workers, emptied by Update()
 };
 #endif
 /// @}
@@ -23,6 +23,8 @@
 #include <ace/os_include/netinet/os_tcp.h>
 #include <ace/os_include/sys/os_types.h>
 #include <ace/os_include/sys/os_socket.h>
+#include <ace/os_include/sys/os_uio.h>
+#include <ace/OS_NS_sys_socket.h>
 #include <ace/OS_NS_string.h>
 #include <ace/Reactor.h>
 #include <ace/Auto_Ptr.h>
@@ -33,6 +35,7 @@
 #include "Util.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 #include "SharedDefines.h"
 #include "ByteBuffer.h"
 #include "Opcodes.h"
@@ -102,6 +105,12 @@ struct ClientPktHeader
 #pragma pack(pop)
 #endif
 
+ACE_Thread_Mutex WorldSocket::m_SendStatsLock;
+uint64 WorldSocket::m_TotalBytesSent = 0;
+uint64 WorldSocket::m_TotalBytesCopied = 0;
+uint64 WorldSocket::m_TotalBytesShared = 0;
+uint64 WorldSocket::m_TotalSendCalls = 0;
+
 WorldSocket::WorldSocket(void) :
     WorldHandler(),
     m_LastPingTime(ACE_Time_Value::zero),
@@ -113,14 +122,14 @@ WorldSocket::WorldSocket(void) :
     m_Header(sizeof(ClientPktHeader)),
     m_OutBuffer(0),
     m_OutBufferSize(65536),
+    m_OutQueueSize(0),
+    m_OutBytesCopied(0),
+    m_OutBytesShared(0),
     m_OutActive(false),
     m_Seed(static_cast<uint32>(rand32()))
 {
     reference_counting_policy().value(ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
 
-    msg_queue()->high_water_mark(8 * 1024 * 1024);
-    msg_queue()->low_water_mark(8 * 1024 * 1024);
-
     m_transferInitiated[0] = false;
     m_transferInitiated[1] = false;
 }
@@ -132,6 +141,9 @@ WorldSocket::~WorldSocket(void)
     if (m_OutBuffer)
         m_OutBuffer->release();
 
+    for (OutQueue::const_iterator itr = m_OutQueue.begin(); itr != m_OutQueue.end(); ++itr)
+        (*itr)->release();
+
     closing_ = true;
 
     peer().close();
@@ -173,11 +185,34 @@ int WorldSocket::SendPacket(const WorldPacket& pct)
     if (closing_)
         return -1;
 
+    return WritePacket(pct, NULL);
+}
+
+int WorldSocket::SendPacket(const SharedWorldPacket& pct)
+{
+    const WorldPacket& packet = pct.GetPacket();
+
+    if (packet.size() < MIN_SHARED_PACKET_SIZE)
+        return SendPacket(packet);
+
+    // created once by the first receiving socket, outside of our lock
+    ACE_Message_Block* payload = pct.GetPayload();
+
+    ACE_GUARD_RETURN(LockType, Guard, m_OutBufferLock, -1);
+
+    if (closing_)
+        return -1;
+
+    return WritePacket(packet, payload);
+}
+
+int WorldSocket::WritePacket(const WorldPacket& pct, ACE_Message_Block* payload)
+{
     // Dump outgoing packet.
     sLog.outWorldPacketDump(uint32(get_handle()), pct.GetOpcode(), pct.GetServerOpcodeName(), &pct, false);
 
     ServerPktHeader header(pct.size() + 2, pct.GetOpcodeValue());
-    
+
     if (m_Crypt.IsInitialized())
     {
         uint32 finalHeader = (pct.size() << 13) | ((uint32)pct.GetOpcodeValue() & 0x1FFF);
@@ -186,38 +221,36 @@ int WorldSocket::SendPacket(const WorldPacket& pct)
         header.header[1] = (uint32)((finalHeader >> 8) & 0xFF);
         header.header[2] = (uint32)((finalHeader >> 16) & 0xFF);
         header.header[3] = (uint32)((finalHeader >> 24) & 0xFF);
-
-        m_Crypt.EncryptSend((uint8*)header.header, header.getHeaderLength());
     }
 
-    if (m_OutBuffer->space() >= pct.size() + header.getHeaderLength() && msg_queue()->is_empty())
-    {
-        // Put the packet on the buffer.
-        if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
-            MANGOS_ASSERT(false);
+    const size_t headerLength = header.getHeaderLength();
 
-        if (!pct.empty())
-            if (m_OutBuffer->copy((char*) pct.contents(), pct.size()) == -1)
-                MANGOS_ASSERT(false);
-    }
-    else
+    if (payload && m_OutQueueSize + payload->length() > MAX_OUT_QUEUE_SIZE)
     {
-        // Enqueue the packet.
-        ACE_Message_Block* mb;
+        sLog.outError("WorldSocket::WritePacket: output queue of %s is full", m_Address.c_str());
+        return -1;
+    }
 
-        ACE_NEW_RETURN(mb, ACE_Message_Block(pct.size() + header.getHeaderLength()), -1);
+    // nothing can be appended after a header that is followed by a shared body, so don't give it a full chunk
+    char* dst = payload ? ReserveOutBuffer(headerLength, true) : ReserveOutBuffer(headerLength + pct.size());
+    if (!dst)
+        return -1;
 
-        mb->copy((char*) header.header, header.getHeaderLength());
+    ACE_OS::memcpy(dst, header.header, headerLength);
 
-        if (!pct.empty())
-            mb->copy((const char*)pct.contents(), pct.size());
+    if (!payload && !pct.empty())
+        ACE_OS::memcpy(dst + headerLength, pct.contents(), pct.size());
 
-        if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-        {
-            sLog.outError("WorldSocket::SendPacket enqueue_tail");
-            mb->release();
-            return -1;
-        }
+    // encrypt the header where it will be sent from
+    if (m_Crypt.IsInitialized())
+        m_Crypt.EncryptSend((uint8*)dst, headerLength);
+
+    // the shared body is full, later output goes to a new chunk after it
+    if (payload)
+    {
+        m_OutQueue.push_back(payload->duplicate());
+        m_OutQueueSize += payload->length();
+        m_OutBytesShared += payload->length();
     }
 
     return 0;
@@ -235,31 +268,57 @@ int WorldSocket::SendRawPacket(const WorldPacket& pct, uint16 size)
     // Dump outgoing packet.
     sLog.outWorldPacketDump(uint32(get_handle()), 0, "RAW", &pct, false);
 
-    if (m_OutBuffer->space() >= size && msg_queue()->is_empty())
-    {
-        if (!pct.empty())
-            if (m_OutBuffer->copy((char*)pct.contents(), size) == -1)
-                MANGOS_ASSERT(false);
-    }
-    else
-    {
-        // Enqueue the packet.
-        ACE_Message_Block* mb;
+    if (pct.empty())
+        return 0;
 
-        ACE_NEW_RETURN(mb, ACE_Message_Block(size), -1);
+    char* dst = ReserveOutBuffer(size);
+    if (!dst)
+        return -1;
+
+    ACE_OS::memcpy(dst, pct.contents(), size);
 
-        if (!pct.empty())
-            mb->copy((const char*)pct.contents(), size);
+    return 0;
+}
 
-        if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+char* WorldSocket::ReserveOutBuffer(size_t size, bool exactBlock /*= false*/)
+{
+    ACE_Message_Block* mb;
+
+    // m_OutBuffer is sent before the queue, so it can only be used while the queue is empty
+    if (m_OutQueue.empty() && m_OutBuffer->space() >= size)
+        mb = m_OutBuffer;
+    // small packets share queued chunks instead of getting a block each
+    else if (!m_OutQueue.empty() && m_OutQueue.back()->space() >= size)
+        mb = m_OutQueue.back();
+    else
+    {
+        if (m_OutQueueSize >= MAX_OUT_QUEUE_SIZE)
         {
-            sLog.outError("WorldSocket::SendPacket enqueue_tail");
-            mb->release();
-            return -1;
+            sLog.outError("WorldSocket::ReserveOutBuffer: output queue of %s is full", m_Address.c_str());
+            return NULL;
         }
+
+        ACE_NEW_RETURN(mb, ACE_Message_Block(exactBlock ? size : std::max(size, m_OutBufferSize)), NULL);
+
+        m_OutQueue.push_back(mb);
+        m_OutQueueSize += mb->size();
     }
 
-    return 0;
+    char* dst = mb->wr_ptr();
+    mb->wr_ptr(size);
+
+    m_OutBytesCopied += size;
+    return dst;
+}
+
+void WorldSocket::GetSendStats(uint64& bytesSent, uint64& bytesCopied, uint64& bytesShared, uint64& sendCalls)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_SendStatsLock);
+
+    bytesSent = m_TotalBytesSent;
+    bytesCopied = m_TotalBytesCopied;
+    bytesShared = m_TotalBytesShared;
+    sendCalls = m_TotalSendCalls;
 }
 
 long WorldSocket::AddReference(void)
@@ -405,15 +464,39 @@ int WorldSocket::handle_output(ACE_HANDLE)
     if (closing_)
         return -1;
 
-    const size_t send_len = m_OutBuffer->length();
+    // gather m_OutBuffer and queued chunks for one send call
+    iovec iov[MAX_OUT_IOVECS];
+    int iovCount = 0;
+    size_t send_len = 0;
+
+    if (m_OutBuffer->length() > 0)
+    {
+        iov[iovCount].iov_base = m_OutBuffer->rd_ptr();
+        iov[iovCount].iov_len = m_OutBuffer->length();
+        send_len += m_OutBuffer->length();
+        ++iovCount;
+    }
+
+    for (OutQueue::const_iterator itr = m_OutQueue.begin(); itr != m_OutQueue.end() && iovCount < MAX_OUT_IOVECS; ++itr)
+    {
+        iov[iovCount].iov_base = (*itr)->rd_ptr();
+        iov[iovCount].iov_len = (*itr)->length();
+        send_len += (*itr)->length();
+        ++iovCount;
+    }
 
     if (send_len == 0)
-        return handle_output_queue(Guard);
+        return cancel_wakeup_output(Guard);
 
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send(m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
+    msghdr msg;
+    ACE_OS::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovCount;
+
+    ssize_t n = ACE_OS::sendmsg(get_handle(), &msg, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer().send(m_OutBuffer->rd_ptr(), send_len);
+    ssize_t n = peer().sendv(iov, iovCount);
 #endif // MSG_NOSIGNAL
 
     if (n == 0)
@@ -425,84 +508,65 @@ int WorldSocket::handle_output(ACE_HANDLE)
 
         return -1;
     }
-    else if (n < (ssize_t)send_len) // now n > 0
-    {
-        m_OutBuffer->rd_ptr(static_cast<size_t>(n));
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
+    ConsumeOutBuffers(static_cast<size_t>(n));
 
-        return schedule_wakeup_output(Guard);
-    }
-    else // now n == send_len
     {
-        m_OutBuffer->reset();
+        ACE_Guard<ACE_Thread_Mutex> statsGuard(m_SendStatsLock);
 
-        return handle_output_queue(Guard);
+        m_TotalBytesSent += n;
+        m_TotalBytesCopied += m_OutBytesCopied;
+        m_TotalBytesShared += m_OutBytesShared;
+        ++m_TotalSendCalls;
     }
 
-    ACE_NOTREACHED(return 0);
-}
-
-int WorldSocket::handle_output_queue(GuardType& g)
-{
-    if (msg_queue()->is_empty())
-        return cancel_wakeup_output(g);
-
-    ACE_Message_Block* mblk;
-
-    if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-    {
-        sLog.outError("WorldSocket::handle_output_queue dequeue_head");
-        return -1;
-    }
+    m_OutBytesCopied = 0;
+    m_OutBytesShared = 0;
 
-    const size_t send_len = mblk->length();
+    if (n < (ssize_t)send_len)
+        return schedule_wakeup_output(Guard);
 
-#ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send(mblk->rd_ptr(), send_len, MSG_NOSIGNAL);
-#else
-    ssize_t n = peer().send(mblk->rd_ptr(), send_len);
-#endif // MSG_NOSIGNAL
+    // more chunks queued than fit in one call
+    if (!m_OutQueue.empty())
+        return ACE_Event_Handler::WRITE_MASK;
 
-    if (n == 0)
-    {
-        mblk->release();
+    return cancel_wakeup_output(Guard);
+}
 
-        return -1;
-    }
-    else if (n == -1)
+void WorldSocket::ConsumeOutBuffers(size_t size)
+{
+    if (size_t length = m_OutBuffer->length())
     {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
+        if (size < length)
         {
-            msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero);
-            return schedule_wakeup_output(g);
+            m_OutBuffer->rd_ptr(size);
+
+            // move the data to the base of the buffer
+            m_OutBuffer->crunch();
+            m_OutBytesCopied += m_OutBuffer->length();
+            return;
         }
 
-        mblk->release();
-        return -1;
+        m_OutBuffer->reset();
+        size -= length;
     }
-    else if (n < (ssize_t)send_len) // now n > 0
+
+    while (size > 0 && !m_OutQueue.empty())
     {
-        mblk->rd_ptr(static_cast<size_t>(n));
+        ACE_Message_Block* mb = m_OutQueue.front();
 
-        if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
+        if (size < mb->length())
         {
-            sLog.outError("WorldSocket::handle_output_queue enqueue_head");
-            mblk->release();
-            return -1;
+            mb->rd_ptr(size);
+            return;
         }
 
-        return schedule_wakeup_output(g);
-    }
-    else // now n == send_len
-    {
-        mblk->release();
+        size -= mb->length();
 
-        return msg_queue()->is_empty() ? cancel_wakeup_output(g) : ACE_Event_Handler::WRITE_MASK;
+        m_OutQueueSize -= mb->size();
+        m_OutQueue.pop_front();
+        mb->release();
     }
-
-    ACE_NOTREACHED(return -1);
 }
 
 int WorldSocket::handle_close(ACE_HANDLE h, ACE_Reactor_Mask)
@@ -533,7 +597,7 @@ int WorldSocket::Update(void)
     if (closing_)
         return -1;
 
-    if (m_OutActive || (m_OutBuffer->length() == 0 && msg_queue()->is_empty()))
+    if (m_OutActive || (m_OutBuffer->length() == 0 && m_OutQueue.empty()))
         return 0;
 
     int ret;
@@ -36,6 +36,8 @@
 #include <ace/Unbounded_Queue.h>
 #include <ace/Message_Block.h>
 
+#include <deque>
+
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
@@ -45,6 +47,7 @@
 #include "Auth/BigNumber.h"
 
 class ACE_Message_Block;
+class SharedWorldPacket;
 class WorldPacket;
 class WorldSession;
 
@@ -60,8 +63,9 @@ typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
  * The class uses reference counting.
  *
  * For output the class uses one buffer (64K usually) and
- * a queue where it stores packet if there is no place on
- * the queue. The reason this is done, is because the server
+ * a queue of 64K chunks where packets go if there is no place
+ * in the buffer, small packets share one chunk. All of them are
+ * sent with one gathering send call. The reason this is done, is because the server
  * does really a lot of small-size writes to it, and it doesn't
  * scale well to allocate memory for every. When something is
  * written to the output buffer the socket is not immediately
@@ -115,8 +119,14 @@ class WorldSocket : protected WorldHandler
         /// @param pct packet to send
         /// @return -1 of failure
         int SendPacket(const WorldPacket& pct);
+        /// Send a broadcast packet, big bodies are queued by reference instead of copied.
+        int SendPacket(const SharedWorldPacket& pct);
         int SendRawPacket(const WorldPacket& pct, uint16 size);
 
+        /// Totals of all sockets: bytes sent, bytes copied into output buffers,
+        /// bytes queued from shared packets and send calls.
+        static void GetSendStats(uint64& bytesSent, uint64& bytesCopied, uint64& bytesShared, uint64& sendCalls);
+
         /// Add reference to this object.
         long AddReference(void);
 
@@ -163,8 +173,17 @@ class WorldSocket : protected WorldHandler
         int cancel_wakeup_output(GuardType& g);
         int schedule_wakeup_output(GuardType& g);
 
-        /// Drain the queue if its not empty.
-        int handle_output_queue(GuardType& g);
+        /// Get place for size bytes of output, in m_OutBuffer or in the queue.
+        /// Called with m_OutBufferLock held, returns NULL if output queue is full.
+        /// @param exactBlock a new queue chunk gets exactly size bytes, for headers followed by a shared body
+        char* ReserveOutBuffer(size_t size, bool exactBlock = false);
+
+        /// Write header and body of pct to the output, called with m_OutBufferLock held.
+        /// @param payload if not NULL, the body is queued as duplicate of this block instead of copied
+        int WritePacket(const WorldPacket& pct, ACE_Message_Block* payload);
+
+        /// Remove size sent bytes from m_OutBuffer and the queue.
+        void ConsumeOutBuffers(size_t size);
 
         /// process one incoming packet.
         /// @param new_pct received packet ,note that you need to delete it.
@@ -216,6 +235,31 @@ class WorldSocket : protected WorldHandler
         /// Size of the m_OutBuffer.
         size_t m_OutBufferSize;
 
+        /// Chunks of output waiting after m_OutBuffer, first one can be partially sent.
+        typedef std::deque<ACE_Message_Block*> OutQueue;
+        OutQueue m_OutQueue;
+
+        /// Allocated size of m_OutQueue chunks.
+        size_t m_OutQueueSize;
+
+        /// Bytes copied into output buffers since last send.
+        size_t m_OutBytesCopied;
+
+        /// Bytes of shared packet bodies queued since last send.
+        size_t m_OutBytesShared;
+
+        static const size_t MAX_OUT_QUEUE_SIZE = 8 * 1024 * 1024;
+        static const int MAX_OUT_IOVECS = 64;
+
+        /// Smaller shared packets are copied, an extra block and iovec would cost more than the copy.
+        static const size_t MIN_SHARED_PACKET_SIZE = 256;
+
+        static ACE_Thread_Mutex m_SendStatsLock;
+        static uint64 m_TotalBytesSent;
+        static uint64 m_TotalBytesCopied;
+        static uint64 m_TotalBytesShared;
+        static uint64 m_TotalSendCalls;
+
         /// True if the socket is registered with the reactor for output
         bool m_OutActive;
 
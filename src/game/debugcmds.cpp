@@ -31,6 +31,16 @@
 #include "ObjectMgr.h"
 #include "ObjectGuid.h"
 #include "SpellMgr.h"
+#include "SpellAuraProcIndex.h"
+#include "Spell.h"
+#include "SpellAreaQuery.h"
+#include "MapManager.h"
+#include "World.h"
+#include "WorldSocket.h"
+#include "SharedWorldPacket.h"
+#include "GridNotifiers.h"
+#include "GridNotifiersImpl.h"
+#include "CellImpl.h"
 
 bool ChatHandler::HandleDebugSendSpellFailCommand(char* args)
 {
@@ -346,6 +356,695 @@ bool ChatHandler::HandleDebugGetLootRecipientCommand(char* /*args*/)
     return true;
 }
 
+// sort maps by average tick time, slowest first
+static bool MapUpdateTimeGreater(Map const* left, Map const* right)
+{
+    return left->GetAvgUpdateTime() > right->GetAvgUpdateTime();
+}
+
+bool ChatHandler::HandleDebugMapUpdateCommand(char* args)
+{
+    uint32 count;
+    if (!ExtractOptUInt32(&args, count, 10))
+        return false;
+
+    MapManager::MapMapType const& maps = sMapMgr.Maps();
+
+    PSendSysMessage("Map update threads: %u, maps: %u, last maps update: %u ms",
+                    sMapMgr.GetMapUpdateThreads(), uint32(maps.size()), sMapMgr.GetLastUpdateTime());
+
+    std::vector<Map*> sortedMaps;
+    sortedMaps.reserve(maps.size());
+    for (MapManager::MapMapType::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+        sortedMaps.push_back(itr->second);
+
+    std::sort(sortedMaps.begin(), sortedMaps.end(), MapUpdateTimeGreater);
+
+    if (count < sortedMaps.size())
+        sortedMaps.resize(count);
+
+    for (std::vector<Map*>::const_iterator itr = sortedMaps.begin(); itr != sortedMaps.end(); ++itr)
+    {
+        Map const* map = *itr;
+        PSendSysMessage("Map %u (%s) instance %u, players %u: last %u ms, avg %u ms, max %u ms",
+                        map->GetId(), map->GetMapName(), map->GetInstanceId(), map->GetPlayers().getSize(),
+                        map->GetLastUpdateTime(), map->GetAvgUpdateTime(), map->GetMaxUpdateTime());
+    }
+
+    return true;
+}
+
+bool ChatHandler::HandleDebugBroadcastBenchCommand(char* args)
+{
+    uint32 receivers;
+    if (!ExtractOptUInt32(&args, receivers, 50) || !receivers || receivers > 1000)
+        return false;
+
+    uint32 size;
+    if (!ExtractOptUInt32(&args, size, 1000) || !size || size > 0xFFFF)
+        return false;
+
+    uint32 iterations;
+    if (!ExtractOptUInt32(&args, iterations, 10000) || !iterations)
+        return false;
+
+    WorldPacket packet(SMSG_SPELL_GO, size);
+    packet.resize(size);
+
+    // copy: every socket appends the body to its own output chunk
+    std::vector<ACE_Message_Block*> outBuffers(receivers);
+    for (uint32 i = 0; i < receivers; ++i)
+        outBuffers[i] = new ACE_Message_Block(size);
+
+    ACE_Time_Value startTime = ACE_OS::gettimeofday();
+
+    for (uint32 n = 0; n < iterations; ++n)
+    {
+        for (uint32 i = 0; i < receivers; ++i)
+        {
+            outBuffers[i]->reset();
+            outBuffers[i]->copy((char const*)packet.contents(), packet.size());
+        }
+    }
+
+    ACE_Time_Value copyTime = ACE_OS::gettimeofday() - startTime;
+
+    for (uint32 i = 0; i < receivers; ++i)
+        outBuffers[i]->release();
+
+    // shared: the body is copied once, every socket queues a duplicate that it releases after the send
+    std::vector<ACE_Message_Block*> queued(receivers);
+    startTime = ACE_OS::gettimeofday();
+
+    for (uint32 n = 0; n < iterations; ++n)
+    {
+        SharedWorldPacket shared(packet);
+        ACE_Message_Block* payload = shared.GetPayload();
+
+        for (uint32 i = 0; i < receivers; ++i)
+            queued[i] = payload->duplicate();
+
+        for (uint32 i = 0; i < receivers; ++i)
+            queued[i]->release();
+    }
+
+    ACE_Time_Value sharedTime = ACE_OS::gettimeofday() - startTime;
+
+    uint64 copyUs = uint64(copyTime.sec()) * 1000000 + uint64(copyTime.usec());
+    uint64 sharedUs = uint64(sharedTime.sec()) * 1000000 + uint64(sharedTime.usec());
+
+    PSendSysMessage("%u byte packet to %u receivers, %u broadcasts", size, receivers, iterations);
+    PSendSysMessage("  copied:  " UI64FMTD " us (%.0f broadcasts/s, %u bytes copied each)", copyUs,
+                    copyUs ? iterations * 1000000.0 / copyUs : 0.0, size * receivers);
+    PSendSysMessage("  shared:  " UI64FMTD " us (%.0f broadcasts/s, %u bytes copied each)", sharedUs,
+                    sharedUs ? iterations * 1000000.0 / sharedUs : 0.0, size);
+    return true;
+}
+
+bool ChatHandler::HandleDebugCompressionCommand(char* /*args*/)
+{
+    UpdateDataCompressionStats stats = UpdateData::GetCompressionStats();
+
+    PSendSysMessage("Update packet compression level %u, threshold %u bytes",
+                    sWorld.getConfig(CONFIG_UINT32_COMPRESSION), sWorld.getConfig(CONFIG_UINT32_COMPRESSION_THRESHOLD));
+
+    if (!stats.packets)
+    {
+        SendSysMessage("No compressed update packets sent yet");
+        return true;
+    }
+
+    uint64 saved = stats.rawBytes - stats.compressedBytes;
+    PSendSysMessage("Compressed packets: " UI64FMTD ", bytes before: " UI64FMTD ", after: " UI64FMTD ", saved: " UI64FMTD " (%.1f%%)",
+                    stats.packets, stats.rawBytes, stats.compressedBytes, saved, float(saved) * 100.0f / stats.rawBytes);
+    PSendSysMessage("Compression time: " UI64FMTD " us total, %.1f us per packet",
+                    stats.compressTime, float(stats.compressTime) / stats.packets);
+    return true;
+}
+
+bool ChatHandler::HandleDebugNetSendCommand(char* /*args*/)
+{
+    uint64 bytesSent, bytesCopied, bytesShared, sendCalls;
+    WorldSocket::GetSendStats(bytesSent, bytesCopied, bytesShared, sendCalls);
+
+    if (!sendCalls)
+    {
+        SendSysMessage("No data sent to clients yet");
+        return true;
+    }
+
+    PSendSysMessage("Sent " UI64FMTD " bytes in " UI64FMTD " send calls (%.1f bytes per call)",
+                    bytesSent, sendCalls, float(bytesSent) / sendCalls);
+    PSendSysMessage("Copied " UI64FMTD " bytes into output buffers, %.3f bytes copied per byte sent",
+                    bytesCopied, float(bytesCopied) / bytesSent);
+    PSendSysMessage("Queued " UI64FMTD " bytes of shared broadcast packets without copy", bytesShared);
+    return true;
+}
+
+void ChatHandler::ShowAsyncDatabaseStatsHelper(char const* name, Database& db)
+{
+    SqlDelayStats stats;
+    db.GetAsyncStats(stats);
+
+    PSendSysMessage("%s database: %u async workers, " UI64FMTD " operations, " UI64FMTD " barrier passes",
+                    name, db.GetAsyncWorkerCount(), stats.operations, stats.barriers);
+    PSendSysMessage("  queue depth:%s", SqlDelayStats::FormatHistogram(stats.queueDepth).c_str());
+    PSendSysMessage("  latency (ms):%s", SqlDelayStats::FormatHistogram(stats.latency).c_str());
+}
+
+bool ChatHandler::HandleDebugDbAsyncCommand(char* /*args*/)
+{
+    ShowAsyncDatabaseStatsHelper("World", WorldDatabase);
+    ShowAsyncDatabaseStatsHelper("Character", CharacterDatabase);
+    ShowAsyncDatabaseStatsHelper("Login", LoginDatabase);
+    return true;
+}
+
+void ChatHandler::ShowDatabaseProfileHelper(char const* name, Database& db, uint32 limit)
+{
+    SqlOperationProfileList profile;
+    db.GetOperationProfile(profile, limit);
+
+    PSendSysMessage("%s database, slowest async statements:", name);
+
+    for (SqlOperationProfileList::const_iterator itr = profile.begin(); itr != profile.end(); ++itr)
+    {
+        SqlOperationStats const& stats = itr->second;
+        PSendSysMessage("  " UI64FMTD " ms total, " UI64FMTD " x, avg " UI64FMTD " us, max " UI64FMTD " us, wait avg " UI64FMTD " us, " UI64FMTD " rows",
+                        stats.execTime / 1000, stats.count, stats.execTime / stats.count, stats.maxExecTime, stats.waitTime / stats.count, stats.rows);
+        PSendSysMessage("    %s", itr->first.c_str());
+        PSendSysMessage("    latency (ms):%s", SqlDelayStats::FormatHistogram(stats.latency).c_str());
+    }
+}
+
+bool ChatHandler::HandleDebugDbStatsCommand(char* args)
+{
+    if (ExtractLiteralArg(&args, "reset"))
+    {
+        WorldDatabase.ResetOperationProfile();
+        CharacterDatabase.ResetOperationProfile();
+        LoginDatabase.ResetOperationProfile();
+        SendSysMessage("Database operation profiles reset.");
+        return true;
+    }
+
+    uint32 limit;
+    if (!ExtractOptUInt32(&args, limit, 5))
+        return false;
+
+    ShowDatabaseProfileHelper("World", WorldDatabase, limit);
+    ShowDatabaseProfileHelper("Character", CharacterDatabase, limit);
+    ShowDatabaseProfileHelper("Login", LoginDatabase, limit);
+    return true;
+}
+
+// read every field of the result the way loaders do, returns the number of rows
+static uint64 ReadAllRows(QueryResult* result, double& checksum)
+{
+    if (!result)
+        return 0;
+
+    uint64 rows = 0;
+    do
+    {
+        Field* fields = result->Fetch();
+        for (uint32 i = 0; i < result->GetFieldCount(); ++i)
+        {
+            switch (fields[i].GetType())
+            {
+                case Field::DB_TYPE_INTEGER: checksum += fields[i].GetUInt32(); break;
+                case Field::DB_TYPE_FLOAT:   checksum += fields[i].GetFloat();  break;
+                default:                     checksum += fields[i].IsNULL() ? 0 : 1; break;
+            }
+        }
+        ++rows;
+    }
+    while (result->NextRow());
+
+    delete result;
+    return rows;
+}
+
+bool ChatHandler::HandleDebugDbLoadBenchCommand(char* args)
+{
+    char* table = ExtractLiteralArg(&args);
+    std::string tableName = table ? table : "creature";
+
+    for (size_t i = 0; i < tableName.size(); ++i)
+    {
+        if (!isalnum(tableName[i]) && tableName[i] != '_')
+            return false;
+    }
+
+    double textChecksum = 0.0;
+    uint32 startTime = WorldTimer::getMSTime();
+    uint64 textRows = ReadAllRows(WorldDatabase.PQuery("SELECT * FROM `%s`", tableName.c_str()), textChecksum);
+    uint32 textTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+    double binaryChecksum = 0.0;
+    startTime = WorldTimer::getMSTime();
+    uint64 binaryRows = ReadAllRows(WorldDatabase.PBinaryQuery("SELECT * FROM `%s`", tableName.c_str()), binaryChecksum);
+    uint32 binaryTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+    if (!textRows)
+    {
+        PSendSysMessage("Table `%s` is empty or can't be read", tableName.c_str());
+        return true;
+    }
+
+    PSendSysMessage("Table `%s`, query + read of all fields:", tableName.c_str());
+    PSendSysMessage("  text results:   " UI64FMTD " rows in %u ms (%.0f rows/s)",
+                    textRows, textTime, textRows * 1000.0 / std::max(textTime, uint32(1)));
+    PSendSysMessage("  binary results: " UI64FMTD " rows in %u ms (%.0f rows/s)",
+                    binaryRows, binaryTime, binaryRows * 1000.0 / std::max(binaryTime, uint32(1)));
+
+    if (textRows != binaryRows)
+        PSendSysMessage("  row count differs!");
+
+    // float columns may differ a bit, text results carry the values rounded by the server
+    DEBUG_LOG("Load bench `%s` checksums: text %f, binary %f", tableName.c_str(), textChecksum, binaryChecksum);
+
+    return true;
+}
+
+bool ChatHandler::HandleDebugDbStmtBenchCommand(char* args)
+{
+    // every statement is a blocking round trip of the world thread
+    uint32 count;
+    if (!ExtractOptUInt32(&args, count, 10000) || !count || count > 100000)
+        return false;
+
+    // no character has guid 0, so the update changes nothing and only statement handling and the round trip are measured
+    uint32 startTime = WorldTimer::getMSTime();
+    for (uint32 i = 0; i < count; ++i)
+        CharacterDatabase.DirectPExecute("UPDATE characters SET at_login = at_login WHERE guid = '%u'", 0);
+    uint32 textTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+    static SqlStatementID benchStmt ;
+
+    startTime = WorldTimer::getMSTime();
+    for (uint32 i = 0; i < count; ++i)
+    {
+        SqlStatement stmt = CharacterDatabase.CreateStatement(benchStmt, "UPDATE characters SET at_login = at_login WHERE guid = ?");
+        stmt.addUInt32(0);
+        stmt.DirectExecute();
+    }
+    uint32 stmtTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+    PSendSysMessage("Character database, %u single row updates:", count);
+    PSendSysMessage("  formatted sql:      %u ms (%.0f statements/s)", textTime, count * 1000.0 / std::max(textTime, uint32(1)));
+    PSendSysMessage("  prepared statement: %u ms (%.0f statements/s)", stmtTime, count * 1000.0 / std::max(stmtTime, uint32(1)));
+    return true;
+}
+
+bool ChatHandler::HandleDebugProcBenchCommand(char* args)
+{
+    uint32 iterations;
+    if (!ExtractOptUInt32(&args, iterations, 100000) || !iterations)
+        return false;
+
+    Unit* target = getSelectedUnit();
+    if (!target)
+    {
+        SendSysMessage(LANG_SELECT_CHAR_OR_CREATURE);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    // candidate selection of a melee swing, once as attacker and once as victim
+    uint32 const procFlags[2] = { PROC_FLAG_SUCCESSFUL_MELEE_HIT, PROC_FLAG_TAKEN_MELEE_HIT | PROC_FLAG_TAKEN_ANY_DAMAGE };
+    Unit::SpellAuraHolderMap const& holders = target->GetSpellAuraHolderMap();
+
+    // full scan, the proc flag part of Unit::IsTriggeredAtSpellProcEvent for every holder
+    uint32 scanCount = 0;
+    ACE_Time_Value startTime = ACE_OS::gettimeofday();
+
+    for (uint32 n = 0; n < iterations; ++n)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            for (Unit::SpellAuraHolderMap::const_iterator itr = holders.begin(); itr != holders.end(); ++itr)
+            {
+                SpellEntry const* spellProto = itr->second->GetSpellProto();
+                SpellProcEventEntry const* spellProcEvent = sSpellMgr.GetSpellProcEvent(spellProto->Id);
+                uint32 eventProcFlag = spellProcEvent && spellProcEvent->procFlags ? spellProcEvent->procFlags : spellProto->GetProcFlags();
+                if ((eventProcFlag & procFlags[i]) || (i == 1 && (spellProto->GetAuraInterruptFlags() & AURA_INTERRUPT_FLAG_DAMAGE)))
+                    ++scanCount;
+            }
+        }
+    }
+
+    ACE_Time_Value scanTime = ACE_OS::gettimeofday() - startTime;
+
+    uint32 indexCount = 0;
+    std::vector<SpellAuraHolder*> candidates;
+    startTime = ACE_OS::gettimeofday();
+
+    for (uint32 n = 0; n < iterations; ++n)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            candidates.clear();
+            target->GetProcCandidates(procFlags[i], i == 1, candidates);
+            indexCount += candidates.size();
+        }
+    }
+
+    ACE_Time_Value indexTime = ACE_OS::gettimeofday() - startTime;
+
+    uint64 scanUs = uint64(scanTime.sec()) * 1000000 + uint64(scanTime.usec());
+    uint64 indexUs = uint64(indexTime.sec()) * 1000000 + uint64(indexTime.usec());
+    SpellAuraProcIndex const* procIndex = target->GetProcIndex();
+
+    PSendSysMessage("%s: %u aura holders, proc index %u entries, proc flags 0x%08X",
+                    target->GetGuidStr().c_str(), uint32(holders.size()),
+                    procIndex ? procIndex->GetSize() : 0, procIndex ? procIndex->GetProcFlagMask() : 0);
+    PSendSysMessage("  full scan:  %u candidates in " UI64FMTD " us (%.0f procs/s)", scanCount / iterations, scanUs, scanUs ? iterations * 2 * 1000000.0 / scanUs : 0.0);
+    PSendSysMessage("  proc index: %u candidates in " UI64FMTD " us (%.0f procs/s)", indexCount / iterations, indexUs, indexUs ? iterations * 2 * 1000000.0 / indexUs : 0.0);
+    return true;
+}
+
+bool ChatHandler::HandleDebugAoEBenchCommand(char* args)
+{
+    uint32 spellid = ExtractSpellIdFromLink(&args);
+    if (!spellid)
+        return false;
+
+    SpellEntry const* spellInfo = sSpellStore.LookupEntry(spellid);
+    if (!spellInfo)
+    {
+        SendSysMessage(LANG_COMMAND_NOSPELLFOUND);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    float radius = 30.0f;
+    ExtractFloat(&args, radius);
+
+    uint32 iterations;
+    if (!ExtractOptUInt32(&args, iterations, 100) || !iterations)
+        return false;
+
+    uint32 const maxTargets = 40;
+
+    Player* player = m_session->GetPlayer();
+    Map* map = player->GetMap();
+
+    // AoE at the player position, all units are targets so the result doesn't depend on the surrounding factions
+    Spell spell(player, spellInfo, true);
+    spell.m_targets.setDestination(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ());
+
+    // old path: cell walk with the grid notifier into a list, then the list based random cut of SetTargetMap
+    Spell::UnitList notifierUnits;
+    ACE_Time_Value startTime = ACE_OS::gettimeofday();
+
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        notifierUnits.clear();
+        MaNGOS::SpellNotifierCreatureAndPlayer notifier(spell, notifierUnits, radius, PUSH_DEST_CENTER, SPELL_TARGETS_ALL);
+        Cell::VisitAllObjects(notifier.GetCenterX(), notifier.GetCenterY(), map, notifier, radius);
+
+        while (notifierUnits.size() > maxTargets)
+        {
+            Spell::UnitList::iterator itr = notifierUnits.begin();
+            std::advance(itr, urand(0, notifierUnits.size() - 1));
+            notifierUnits.erase(itr);
+        }
+    }
+
+    ACE_Time_Value notifierTime = ACE_OS::gettimeofday() - startTime;
+
+    // spell code: the area query of FillAreaTargets and the random cut of LimitTargetsRandomly
+    Spell::UnitList spellUnits;
+    startTime = ACE_OS::gettimeofday();
+
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        SpellAreaQuery query(*map);
+        query.SelectSpellTargets(spell, radius, PUSH_DEST_CENTER, SPELL_TARGETS_ALL);
+        query.KeepRandom(maxTargets);
+
+        spellUnits.clear();
+        query.AppendTo(spellUnits);
+    }
+
+    ACE_Time_Value spellTime = ACE_OS::gettimeofday() - startTime;
+
+    uint64 notifierUs = uint64(notifierTime.sec()) * 1000000 + uint64(notifierTime.usec());
+    uint64 spellUs = uint64(spellTime.sec()) * 1000000 + uint64(spellTime.usec());
+
+    PSendSysMessage("AoE of spell %u, radius %.1f, up to %u targets, %u casts", spellid, radius, maxTargets, iterations);
+    PSendSysMessage("  notifiers:  %u targets in " UI64FMTD " us (%.0f casts/s)", uint32(notifierUnits.size()), notifierUs, notifierUs ? iterations * 1000000.0 / notifierUs : 0.0);
+    PSendSysMessage("  area query: %u targets in " UI64FMTD " us (%.0f casts/s)", uint32(spellUnits.size()), spellUs, spellUs ? iterations * 1000000.0 / spellUs : 0.0);
+    return true;
+}
+
+bool ChatHandler::HandleDebugFlushBenchCommand(char* args)
+{
+    uint32 iterations;
+    if (!ExtractOptUInt32(&args, iterations, 100) || !iterations)
+        return false;
+
+    Player* player = m_session->GetPlayer();
+    Map* map = player->GetMap();
+
+    // units in visibility range as changed objects, each one with the players of the map that have it at client
+    std::vector<WorldObject*> objects;
+    map->GetPositionIndex().GetObjectsInRange(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ(),
+            map->GetVisibilityDistance(), TYPEMASK_UNIT, false, objects);
+
+    // in std::set order, so both flushes walk the objects in the same order
+    std::sort(objects.begin(), objects.end(), std::less<Object*>());
+
+    std::vector<std::vector<Player*> > viewers(objects.size());
+    uint32 blockCount = 0;
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        for (Map::PlayerList::const_iterator itr = map->GetPlayers().begin(); itr != map->GetPlayers().end(); ++itr)
+            if (itr->getSource()->HaveAtClient(objects[i]))
+                viewers[i].push_back(itr->getSource());
+
+        blockCount += viewers[i].size();
+    }
+
+    // old pipeline: std::set queue, UpdateData searched per viewer in a map
+    typedef UNORDERED_MAP<Player*, UpdateData> UpdateDataMap;
+    ACE_Time_Value startTime = ACE_OS::gettimeofday();
+
+    for (uint32 n = 0; n < iterations; ++n)
+    {
+        std::set<Object*> queue;
+        for (size_t i = 0; i < objects.size(); ++i)
+            queue.insert(objects[i]);
+
+        UpdateDataMap updateData;
+        for (size_t i = 0; !queue.empty(); ++i)
+        {
+            Object* obj = *queue.begin();
+            queue.erase(queue.begin());
+
+            for (std::vector<Player*>::const_iterator itr = viewers[i].begin(); itr != viewers[i].end(); ++itr)
+            {
+                UpdateDataMap::iterator data = updateData.find(*itr);
+                if (data == updateData.end())
+                    data = updateData.insert(UpdateDataMap::value_type(*itr, UpdateData((*itr)->GetMapId()))).first;
+
+                obj->BuildValuesUpdateBlockForPlayer(&data->second, *itr);
+            }
+        }
+    }
+
+    ACE_Time_Value setTime = ACE_OS::gettimeofday() - startTime;
+
+    // Map::SendObjectUpdates(): flat queue and indexed update batch, both reused over the ticks
+    std::vector<Object*> queue;
+    UpdateDataBatch batch;
+    startTime = ACE_OS::gettimeofday();
+
+    for (uint32 n = 0; n < iterations; ++n)
+    {
+        for (size_t i = 0; i < objects.size(); ++i)
+            queue.push_back(objects[i]);
+
+        for (size_t i = 0; i < queue.size(); ++i)
+        {
+            Object* obj = queue[i];
+            queue[i] = NULL;
+
+            for (std::vector<Player*>::const_iterator itr = viewers[i].begin(); itr != viewers[i].end(); ++itr)
+                obj->BuildValuesUpdateBlockForPlayer(&batch.GetUpdateData(*itr), *itr);
+        }
+
+        queue.clear();
+        batch.Clear();
+    }
+
+    ACE_Time_Value batchTime = ACE_OS::gettimeofday() - startTime;
+
+    uint64 setUs = uint64(setTime.sec()) * 1000000 + uint64(setTime.usec());
+    uint64 batchUs = uint64(batchTime.sec()) * 1000000 + uint64(batchTime.usec());
+    double flushed = double(objects.size()) * iterations * 1000.0;
+
+    // packets are neither built nor sent, that part is the same for both
+    PSendSysMessage("%u objects with %u values blocks for %u players, %u flushes", uint32(objects.size()), blockCount,
+                    uint32(map->GetPlayers().getSize()), iterations);
+    PSendSysMessage("  set + map:      " UI64FMTD " us (%.0f objects/ms)", setUs, setUs ? flushed / setUs : 0.0);
+    PSendSysMessage("  vector + batch: " UI64FMTD " us (%.0f objects/ms)", batchUs, batchUs ? flushed / batchUs : 0.0);
+    return true;
+}
+
+bool ChatHandler::HandleDebugValuesBenchCommand(char* args)
+{
+    uint32 viewerCount;
+    if (!ExtractOptUInt32(&args, viewerCount, 40) || !viewerCount)
+        return false;
+
+    uint32 iterations;
+    if (!ExtractOptUInt32(&args, iterations, 1000) || !iterations)
+        return false;
+
+    Unit* target = getSelectedUnit();
+    if (!target)
+    {
+        SendSysMessage(LANG_SELECT_CHAR_OR_CREATURE);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    // players of the map that have the target at client, repeated up to the wanted viewer count
+    Map* map = target->GetMap();
+    std::vector<Player*> players;
+    for (Map::PlayerList::const_iterator itr = map->GetPlayers().begin(); itr != map->GetPlayers().end(); ++itr)
+        if (itr->getSource()->HaveAtClient(target))
+            players.push_back(itr->getSource());
+
+    if (players.empty())
+    {
+        SendSysMessage(LANG_PLAYER_NOT_FOUND);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    std::vector<Player*> viewers;
+    for (uint32 i = 0; i < viewerCount; ++i)
+        viewers.push_back(players[i % players.size()]);
+
+    uint32 fieldCount = 0;
+    for (uint16 i = 0; i < target->GetValuesCount(); ++i)
+        if (target->GetUInt32Value(i))
+            ++fieldCount;
+
+    UpdateDataBatch batch;
+    ACE_Time_Value startTime = ACE_OS::gettimeofday();
+
+    for (uint32 n = 0; n < iterations; ++n)
+    {
+        target->BuildFullValuesUpdateBlocks(viewers, false, batch);
+        batch.Clear();
+    }
+
+    ACE_Time_Value perViewerTime = ACE_OS::gettimeofday() - startTime;
+
+    bool shared = false;
+    startTime = ACE_OS::gettimeofday();
+
+    for (uint32 n = 0; n < iterations; ++n)
+    {
+        shared = target->BuildFullValuesUpdateBlocks(viewers, true, batch);
+        batch.Clear();
+    }
+
+    ACE_Time_Value sharedTime = ACE_OS::gettimeofday() - startTime;
+
+    uint64 perViewerUs = uint64(perViewerTime.sec()) * 1000000 + uint64(perViewerTime.usec());
+    uint64 sharedUs = uint64(sharedTime.sec()) * 1000000 + uint64(sharedTime.usec());
+    double blockCount = double(viewerCount) * iterations;
+
+    PSendSysMessage("%s: %u of %u fields set, %u viewers (%u players at client), %u flushes",
+                    target->GetGuidStr().c_str(), fieldCount, uint32(target->GetValuesCount()), viewerCount, uint32(players.size()), iterations);
+    PSendSysMessage("  per viewer:       " UI64FMTD " us (%.3f us per viewer)", perViewerUs, perViewerUs / blockCount);
+    PSendSysMessage("  per viewer class: " UI64FMTD " us (%.3f us per viewer)%s", sharedUs, sharedUs / blockCount,
+                    shared ? "" : ", not shareable, built per viewer too");
+    return true;
+}
+
+bool ChatHandler::HandleDebugRangeQueryCommand(char* args)
+{
+    float radius = 30.0f;
+    ExtractFloat(&args, radius);
+
+    uint32 iterations;
+    if (!ExtractOptUInt32(&args, iterations, 100) || !iterations)
+        return false;
+
+    Player* player = m_session->GetPlayer();
+    Map* map = player->GetMap();
+
+    // current path: cell walk with the grid notifiers
+    std::list<Unit*> notifierUnits;
+    ACE_Time_Value startTime = ACE_OS::gettimeofday();
+
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        notifierUnits.clear();
+        MaNGOS::AnyUnitInObjectRangeCheck u_check(player, radius);
+        MaNGOS::UnitListSearcher<MaNGOS::AnyUnitInObjectRangeCheck> searcher(notifierUnits, u_check);
+        Cell::VisitAllObjects(player, searcher, radius);
+    }
+
+    ACE_Time_Value notifierTime = ACE_OS::gettimeofday() - startTime;
+
+    // position index: distance filter, then the same check on the candidates
+    std::vector<WorldObject*> candidates;
+    std::vector<Unit*> indexUnits;
+    startTime = ACE_OS::gettimeofday();
+
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        candidates.clear();
+        indexUnits.clear();
+        map->GetPositionIndex().GetObjectsInRange(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ(),
+                radius + player->GetObjectBoundingRadius(), TYPEMASK_UNIT, true, candidates);
+
+        MaNGOS::AnyUnitInObjectRangeCheck u_check(player, radius);
+        for (std::vector<WorldObject*>::const_iterator itr = candidates.begin(); itr != candidates.end(); ++itr)
+        {
+            Unit* unit = (Unit*)*itr;
+            if (unit->InSamePhase(player) && u_check(unit))
+                indexUnits.push_back(unit);
+        }
+    }
+
+    ACE_Time_Value indexTime = ACE_OS::gettimeofday() - startTime;
+
+    PSendSysMessage("Map position index: %u units in %u cells", map->GetPositionIndex().GetSize(), map->GetPositionIndex().GetBucketCount());
+    PSendSysMessage("Radius %.1f, %u queries: notifiers found %u units in " UI64FMTD " us, index found %u units (%u candidates) in " UI64FMTD " us",
+                    radius, iterations,
+                    uint32(notifierUnits.size()), uint64(notifierTime.usec()) + uint64(notifierTime.sec()) * 1000000,
+                    uint32(indexUnits.size()), uint32(candidates.size()), uint64(indexTime.usec()) + uint64(indexTime.sec()) * 1000000);
+    return true;
+}
+
+bool ChatHandler::HandleDebugRecvQueueCommand(char* args)
+{
+    Player* target;
+    if (!ExtractPlayerTarget(&args, &target))
+        return false;
+
+    if (!target)
+    {
+        SendSysMessage(LANG_PLAYER_NOT_FOUND);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    WorldSession* session = target->GetSession();
+    PSendSysMessage("Receive queue of %s (account %u): %u of %u packets queued, peak %u, dropped %u",
+                    GetNameLink(target).c_str(), session->GetAccountId(), session->GetRecvQueueSize(),
+                    session->GetRecvQueueCapacity(), session->GetRecvQueuePeak(), session->GetRecvQueueDropped());
+    return true;
+}
+
 bool ChatHandler::HandleDebugSendQuestInvalidMsgCommand(char* args)
 {
     uint32 msg = atol(args);
@@ -1050,6 +1749,98 @@ bool ChatHandler::HandleDebugModValueCommand(char* args)
     return HandlerDebugModValueHelper(target, field, typeStr, valStr);
 }
 
+bool ChatHandler::HandleDebugSpellInfoCommand(char* args)
+{
+    uint32 iterations;
+    if (!ExtractOptUInt32(&args, iterations, 10) || !iterations)
+        return false;
+
+    // old effect lookup: a map keyed by spell id
+    typedef std::map<uint32, SpellEffectEntry const*> EffectLookupMap;
+    EffectLookupMap effectMap;
+    for (uint32 i = 1; i < sSpellEffectStore.GetNumRows(); ++i)
+        if (SpellEffectEntry const* spellEffect = sSpellEffectStore.LookupEntry(i))
+            if (spellEffect->EffectIndex < MAX_EFFECT_INDEX)
+                effectMap[spellEffect->EffectSpellId * MAX_EFFECT_INDEX + spellEffect->EffectIndex] = spellEffect;
+
+    // per cast data a spell touches: effects, power, category, proc data, positivity
+    uint32 spellCount = 0;
+    uint64 rawSum = 0;
+    ACE_Time_Value startTime = ACE_OS::gettimeofday();
+
+    for (uint32 n = 0; n < iterations; ++n)
+    {
+        for (uint32 id = 1; id < sSpellStore.GetNumRows(); ++id)
+        {
+            SpellEntry const* spell = sSpellStore.LookupEntry(id);
+            if (!spell)
+                continue;
+
+            ++spellCount;
+            for (int i = 0; i < MAX_EFFECT_INDEX; ++i)
+            {
+                EffectLookupMap::const_iterator itr = effectMap.find(id * MAX_EFFECT_INDEX + i);
+                if (itr == effectMap.end())
+                    continue;
+
+                rawSum += itr->second->Effect;
+                if (CalculatePositiveEffect(spell, SpellEffectIndex(i)))
+                    ++rawSum;
+            }
+
+            if (SpellPowerEntry const* power = spell->SpellPowerId ? sSpellPowerStore.LookupEntry(spell->SpellPowerId) : NULL)
+                rawSum += power->manaCost;
+            if (SpellCategoriesEntry const* categories = spell->SpellCategoriesId ? sSpellCategoriesStore.LookupEntry(spell->SpellCategoriesId) : NULL)
+                rawSum += categories->Category;
+            if (SpellAuraOptionsEntry const* auraOptions = spell->SpellAuraOptionsId ? sSpellAuraOptionsStore.LookupEntry(spell->SpellAuraOptionsId) : NULL)
+                rawSum += auraOptions->procFlags;
+        }
+    }
+
+    ACE_Time_Value rawTime = ACE_OS::gettimeofday() - startTime;
+
+    uint64 infoSum = 0;
+    startTime = ACE_OS::gettimeofday();
+
+    for (uint32 n = 0; n < iterations; ++n)
+    {
+        for (uint32 id = 1; id < sSpellStore.GetNumRows(); ++id)
+        {
+            SpellInfo const* info = GetSpellInfo(id);
+            if (!info || !info->entry)
+                continue;
+
+            for (int i = 0; i < MAX_EFFECT_INDEX; ++i)
+            {
+                if (!info->effects[i])
+                    continue;
+
+                infoSum += info->effects[i]->Effect;
+                if (info->IsPositiveEffect(SpellEffectIndex(i)))
+                    ++infoSum;
+            }
+
+            if (info->power)
+                infoSum += info->power->manaCost;
+            if (info->categories)
+                infoSum += info->categories->Category;
+            infoSum += info->procFlags;
+        }
+    }
+
+    ACE_Time_Value infoTime = ACE_OS::gettimeofday() - startTime;
+
+    uint64 rawUs = uint64(rawTime.sec()) * 1000000 + uint64(rawTime.usec());
+    uint64 infoUs = uint64(infoTime.sec()) * 1000000 + uint64(infoTime.usec());
+
+    PSendSysMessage("Spell data of %u spells, %u passes:", spellCount / iterations, iterations);
+    PSendSysMessage("  store lookups: " UI64FMTD " us (%.0f spells/s)", rawUs, rawUs ? spellCount * 1000000.0 / rawUs : 0.0);
+    PSendSysMessage("  SpellInfo:     " UI64FMTD " us (%.0f spells/s)", infoUs, infoUs ? spellCount * 1000000.0 / infoUs : 0.0);
+    if (rawSum != infoSum)
+        PSendSysMessage("  results differ (" UI64FMTD " != " UI64FMTD "), SpellInfo is out of date", rawSum, infoSum);
+    return true;
+}
+
 bool ChatHandler::HandleDebugSpellCoefsCommand(char* args)
 {
     uint32 spellid = ExtractSpellIdFromLink(&args);
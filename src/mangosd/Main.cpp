@@ -22,6 +22,7 @@
 
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/SQLStorageSnapshot.h"
 #include "Config/Config.h"
 #include "ProgressBar.h"
 #include "Log.h"
@@ -64,6 +65,8 @@ void usage(const char* prog)
                    "    -v, --version            print version and exist\n\r"
                    "    -c config_file           use config_file as configuration file\n\r"
                    "    -a, --ahbot config_file  use config_file as ahbot configuration file\n\r"
+                   "    --rebuild-snapshots      rebuild all world table snapshots from the database\n\r"
+                   "    --verify-snapshots       load world tables from the database and compare them with their snapshots\n\r"
 #ifdef WIN32
                    "    Running as service functions:\n\r"
                    "    -s run                   run as service\n\r"
@@ -88,6 +91,8 @@ extern int main(int argc, char** argv)
     ACE_Get_Opt cmd_opts(argc, argv, options);
     cmd_opts.long_option("version", 'v', ACE_Get_Opt::NO_ARG);
     cmd_opts.long_option("ahbot", 'a', ACE_Get_Opt::ARG_REQUIRED);
+    cmd_opts.long_option("rebuild-snapshots", 'R', ACE_Get_Opt::NO_ARG);
+    cmd_opts.long_option("verify-snapshots", 'V', ACE_Get_Opt::NO_ARG);
 
     char serviceDaemonMode = '\0';
 
@@ -102,6 +107,12 @@ extern int main(int argc, char** argv)
             case 'c':
                 cfg_file = cmd_opts.opt_arg();
                 break;
+            case 'R':
+                SQLStorageSnapshot::SetMode(SQLStorageSnapshot::SNAPSHOT_REBUILD);
+                break;
+            case 'V':
+                SQLStorageSnapshot::SetMode(SQLStorageSnapshot::SNAPSHOT_VERIFY);
+                break;
             case 'v':
                 printf("%s\n", _FULLVERSION(REVISION_DATE, REVISION_TIME, REVISION_NR, REVISION_ID));
                 return 0;
@@ -21,126 +21,73 @@
 #include <string.h>
 #include "DB2FileLoader.h"
 
+#include <ace/Mem_Map.h>
+
 DB2FileLoader::DB2FileLoader()
 {
     data = NULL;
+    stringTable = NULL;
     fieldsOffset = NULL;
+    fileMap = NULL;
 }
 
 bool DB2FileLoader::Load(const char *filename, const char *fmt)
 {
-    uint32 header = 48;
-    if(data)
-    {
-        delete [] data;
-        data=NULL;
-    }
+    FreeData();
 
-    FILE * f = fopen(filename, "rb");
-    if(!f)return false;
+    uint32 header[12];                                      // WDBC header fields followed by the WDB2 ones
 
-    if(fread(&header, 4, 1, f) != 1)                        // Signature
+    // prefer a private mapping of the file, see DBCFileLoader::Load
+    fileMap = new ACE_Mem_Map();
+    if (fileMap->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_RDWR, ACE_MAP_PRIVATE) == 0 &&
+            fileMap->size() >= sizeof(header))
     {
-        fclose(f);
-        return false;
+        fileMap->close_handle();
+        memcpy(header, fileMap->addr(), sizeof(header));
     }
-
-    EndianConvert(header);
-
-    if(header != 0x32424457)
-    {
-        fclose(f);
-        return false;                                       //'WDB2'
-    }
-
-    if(fread(&recordCount,4,1,f)!=1)                        // Number of records
+    else
     {
-        fclose(f);
-        return false;
+        delete fileMap;
+        fileMap = NULL;
     }
 
-    EndianConvert(recordCount);
-
-    if(fread(&fieldCount,4,1,f)!=1)                         // Number of fields
+    FILE * f = NULL;
+    if (!fileMap)
     {
-        fclose(f);
-        return false;
-    }
+        f = fopen(filename, "rb");
+        if(!f)return false;
 
-    EndianConvert(fieldCount);
-
-    if(fread(&recordSize,4,1,f)!=1)                         // Size of a record
-    {
-        fclose(f);
-        return false;
+        if(fread(header, sizeof(header), 1, f) != 1)
+        {
+            fclose(f);
+            return false;
+        }
     }
 
-    EndianConvert(recordSize);
+    for(uint32 i = 0; i < 12; ++i)
+        EndianConvert(header[i]);
 
-    if(fread(&stringSize,4,1,f)!=1)                         // String size
+    if(header[0] != 0x32424457)                             //'WDB2'
     {
-        fclose(f);
+        if (f)
+            fclose(f);
+        FreeData();
         return false;
     }
 
-    EndianConvert(stringSize);
+    recordCount = header[1];                                // Number of records
+    fieldCount = header[2];                                 // Number of fields
+    recordSize = header[3];                                 // Size of a record
+    stringSize = header[4];                                 // String size
 
     /* NEW WDB2 FIELDS*/
-    if(fread(&tableHash,4,1,f)!=1)                          // Table hash
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(tableHash);
-
-    if(fread(&build,4,1,f)!=1)                              // Build
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(build);
-
-    if(fread(&unk1,4,1,f)!=1)                               // Unknown WDB2
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(unk1);
-
-    if(fread(&unk2,4,1,f)!=1)                               // Unknown WDB2
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(unk2);
-
-    if(fread(&unk3,4,1,f)!=1)                               // Unknown WDB2
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(unk3);
-
-    if(fread(&locale,4,1,f)!=1)                             // Locales
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(locale);
-
-    if(fread(&unk5,4,1,f)!=1)                               // Unknown WDB2
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(unk5);
+    tableHash = header[5];                                  // Table hash
+    build = header[6];                                      // Build
+    unk1 = int(header[7]);                                  // Unknown WDB2
+    unk2 = int(header[8]);                                  // Unknown WDB2
+    unk3 = int(header[9]);                                  // Unknown WDB2
+    locale = int(header[10]);                               // Locales
+    unk5 = int(header[11]);                                 // Unknown WDB2
 
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
@@ -153,25 +100,91 @@ bool DB2FileLoader::Load(const char *filename, const char *fmt)
             fieldsOffset[i] += 4;
     }
 
-    data = new unsigned char[recordSize*recordCount+stringSize];
-    stringTable = data + recordSize*recordCount;
+    size_t dataSize = size_t(recordSize) * recordCount + stringSize;
 
-    if(fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
+    if (fileMap)
     {
+        if (fileMap->size() < sizeof(header) + dataSize)   // truncated file
+        {
+            FreeData();
+            return false;
+        }
+
+        data = (unsigned char*)fileMap->addr() + sizeof(header);
+    }
+    else
+    {
+        data = new unsigned char[dataSize];
+
+        bool readOk = fread(data, dataSize, 1, f) == 1;
         fclose(f);
-        return false;
+
+        if (!readOk)
+        {
+            FreeData();
+            return false;
+        }
     }
 
-    fclose(f);
+    stringTable = data + size_t(recordSize) * recordCount;
     return true;
 }
 
 DB2FileLoader::~DB2FileLoader()
 {
-    if(data)
+    FreeData();
+}
+
+void DB2FileLoader::FreeData()
+{
+    if (fileMap)
+    {
+        delete fileMap;                                     // unmaps the file
+        fileMap = NULL;
+    }
+    else
         delete [] data;
-    if(fieldsOffset)
-        delete [] fieldsOffset;
+
+    data = NULL;
+    stringTable = NULL;
+
+    delete [] fieldsOffset;
+    fieldsOffset = NULL;
+}
+
+int32 DB2FileLoader::GetDirectRecordOffset(const char* format) const
+{
+#if MANGOS_ENDIAN == MANGOS_LITTLEENDIAN
+    // same rules as DBCFileLoader::GetDirectRecordOffset
+    int32 firstField = -1;
+    bool runEnded = false;
+
+    for(uint32 x = 0; x < fieldCount; ++x)
+    {
+        switch(format[x])
+        {
+            case FT_FLOAT:
+            case FT_INT:
+            case FT_IND:
+                if (runEnded)
+                    return -1;
+                if (firstField < 0)
+                    firstField = x;
+                break;
+            case FT_NA:
+            case FT_SORT:
+                if (firstField >= 0)
+                    runEnded = true;
+                break;
+            default:
+                return -1;
+        }
+    }
+
+    return firstField >= 0 ? int32(GetOffset(firstField)) : -1;
+#else
+    return -1;
+#endif
 }
 
 DB2FileLoader::Record DB2FileLoader::getRecord(size_t id)
@@ -277,6 +290,19 @@ char* DB2FileLoader::AutoProduceData(const char* format, uint32& records, char**
         indexTable = new ptr[recordCount];
     }
 
+    int32 directOffset = GetDirectRecordOffset(format);
+    if (directOffset >= 0)
+    {
+        // file records already have the struct layout, point at them instead of copying
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            char* record = (char*)(data + size_t(y) * recordSize + directOffset);
+            indexTable[i >= 0 ? getRecord(y).getUInt(i) : y] = record;
+        }
+
+        return NULL;
+    }
+
     char* dataTable= new char[recordCount*recordsize];
 
     uint32 offset=0;
@@ -389,17 +415,14 @@ char* DB2FileLoader::AutoProduceStringsArrayHolders(const char* format, char* da
     return stringHoldersPool;
 }
 
-char* DB2FileLoader::AutoProduceStrings(const char* format, char* dataTable, LocaleConstant loc)
+bool DB2FileLoader::AutoProduceStrings(const char* format, char* dataTable, LocaleConstant loc)
 {
     if(strlen(format)!=fieldCount)
-        return NULL;
+        return false;
 
     // each string field at load have array of string for each locale
     size_t stringHolderSize = sizeof(char*) * MAX_LOCALE;
 
-    char* stringPool= new char[stringSize];
-    memcpy(stringPool,stringTable,stringSize);
-
     uint32 offset=0;
 
     for(uint32 y =0; y < recordCount; ++y)
@@ -426,8 +449,8 @@ char* DB2FileLoader::AutoProduceStrings(const char* format, char* dataTable, Loc
                     // fill only not filled entries
                     if (*slot == nullStr)
                     {
-                        const char * st = getRecord(y).getString(x);
-                        *slot=stringPool+(st-(const char*)stringTable);
+                        // no copy, the store keeps the loader and so the file data alive
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
                     }
 
                     offset+=sizeof(char*);
@@ -447,5 +470,5 @@ char* DB2FileLoader::AutoProduceStrings(const char* format, char* dataTable, Loc
         }
     }
 
-    return stringPool;
+    return true;
 }
@@ -24,6 +24,8 @@
 #include "Common.h"
 #include <cassert>
 
+class ACE_Mem_Map;
+
 class DB2FileLoader
 {
     public:
@@ -80,12 +82,17 @@ class DB2FileLoader
     uint32 GetCols() const { return fieldCount; }
     uint32 GetOffset(size_t id) const { return (fieldsOffset != NULL && id < fieldCount) ? fieldsOffset[id] : 0; }
     bool IsLoaded() const { return (data != NULL); }
+    bool IsMapped() const { return fileMap != NULL; }
+    // returns NULL and fills indexTable with pointers into the file data if the format matches the file layout
     char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable);
     char* AutoProduceStringsArrayHolders(const char* fmt, char* dataTable);
-    char* AutoProduceStrings(const char* fmt, char* dataTable, LocaleConstant loc);
+    // string slots point into the file data, the loader must stay alive as long as they are used
+    bool AutoProduceStrings(const char* fmt, char* dataTable, LocaleConstant loc);
     static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
     static uint32 GetFormatStringsFields(const char * format);
 private:
+    void FreeData();
+    int32 GetDirectRecordOffset(const char* format) const;
 
     uint32 recordSize;
     uint32 recordCount;
@@ -94,6 +101,7 @@ private:
     uint32 *fieldsOffset;
     unsigned char *data;
     unsigned char *stringTable;
+    ACE_Mem_Map *fileMap;                                   // NULL if the file was read into data
 
     // WDB2 / WCH2 fields
     uint32 tableHash;    // WDB2
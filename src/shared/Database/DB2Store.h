@@ -25,6 +25,7 @@ template<class T>
 class DB2Storage
 {
     typedef std::list<char*> StringPoolList;
+    typedef std::list<DB2FileLoader*> FileLoaderList;
 public:
     explicit DB2Storage(const char *f) : nCount(0), fieldCount(0), fmt(f), indexTable(NULL), m_dataTable(NULL) { }
     ~DB2Storage() { Clear(); }
@@ -36,21 +37,27 @@ public:
 
     bool Load(char const* fn, LocaleConstant loc)
     {
-        DB2FileLoader db2;
+        DB2FileLoader* db2 = new DB2FileLoader;
         // Check if load was sucessful, only then continue
-        if(!db2.Load(fn, fmt))
+        if(!db2->Load(fn, fmt))
+        {
+            delete db2;
             return false;
+        }
+
+        // records and strings may be used in place, keep the (mapped) file data with the store
+        m_fileList.push_back(db2);
 
-        fieldCount = db2.GetCols();
+        fieldCount = db2->GetCols();
 
-        // load raw non-string data
-        m_dataTable = (T*)db2.AutoProduceData(fmt,nCount,(char**&)indexTable);
+        // load raw non-string data, stays NULL if the records are used in place
+        m_dataTable = (T*)db2->AutoProduceData(fmt,nCount,(char**&)indexTable);
 
         // create string holders for loaded string fields
-        m_stringPoolList.push_back(db2.AutoProduceStringsArrayHolders(fmt,(char*)m_dataTable));
+        m_stringPoolList.push_back(db2->AutoProduceStringsArrayHolders(fmt,(char*)m_dataTable));
 
         // load strings from dbc data
-        m_stringPoolList.push_back(db2.AutoProduceStrings(fmt,(char*)m_dataTable,loc));
+        db2->AutoProduceStrings(fmt,(char*)m_dataTable,loc);
 
         // error in dbc file at loading if NULL
         return indexTable!=NULL;
@@ -62,19 +69,27 @@ public:
         if(!indexTable)
             return false;
 
-        DB2FileLoader db2;
+        DB2FileLoader* db2 = new DB2FileLoader;
         // Check if load was successful, only then continue
-        if(!db2.Load(fn, fmt))
+        // and load strings from another locale dbc data
+        if(!db2->Load(fn, fmt) || !db2->AutoProduceStrings(fmt,(char*)m_dataTable,loc))
+        {
+            delete db2;
             return false;
+        }
 
-        // load strings from another locale dbc data
-        m_stringPoolList.push_back(db2.AutoProduceStrings(fmt,(char*)m_dataTable,loc));
-
+        m_fileList.push_back(db2);
         return true;
     }
 
     void Clear()
     {
+        while(!m_fileList.empty())
+        {
+            delete m_fileList.front();
+            m_fileList.pop_front();
+        }
+
         if (!indexTable)
             return;
 
@@ -100,6 +115,7 @@ private:
     T** indexTable;
     T* m_dataTable;
     StringPoolList m_stringPoolList;
+    FileLoaderList m_fileList;
 };
 
 #endif
@@ -22,46 +22,68 @@
 
 #include "DBCFileLoader.h"
 
+#include <ace/Mem_Map.h>
+
 DBCFileLoader::DBCFileLoader()
 {
     data = NULL;
+    stringTable = NULL;
     fieldsOffset = NULL;
+    fileMap = NULL;
 }
 
 bool DBCFileLoader::Load(const char* filename, const char* fmt)
 {
-    uint32 header;
-    delete[] data;
-
-    FILE* f = fopen(filename, "rb");
-    if (!f)return false;
+    FreeData();
 
-    if (fread(&header, 4, 1, f) != 1)                       // Number of records
-        return false;
+    uint32 header[5];                                       // signature, records, fields, record size, string size
 
-    EndianConvert(header);
-    if (header != 0x43424457)
-        return false;                                       //'WDBC'
-
-    if (fread(&recordCount, 4, 1, f) != 1)                  // Number of records
-        return false;
-
-    EndianConvert(recordCount);
-
-    if (fread(&fieldCount, 4, 1, f) != 1)                   // Number of fields
-        return false;
+    // prefer a private mapping of the file, records and strings are then used in place
+    // and only the touched pages become resident
+    fileMap = new ACE_Mem_Map();
+    if (fileMap->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_RDWR, ACE_MAP_PRIVATE) == 0 &&
+            fileMap->size() >= sizeof(header))
+    {
+        // the mapping stays valid without the file handle
+        fileMap->close_handle();
+        memcpy(header, fileMap->addr(), sizeof(header));
+    }
+    else
+    {
+        delete fileMap;
+        fileMap = NULL;
+    }
 
-    EndianConvert(fieldCount);
+    FILE* f = NULL;
+    if (!fileMap)
+    {
+        // mapping not possible, read the whole file into memory
+        f = fopen(filename, "rb");
+        if (!f)
+            return false;
 
-    if (fread(&recordSize, 4, 1, f) != 1)                   // Size of a record
-        return false;
+        if (fread(header, sizeof(header), 1, f) != 1)
+        {
+            fclose(f);
+            return false;
+        }
+    }
 
-    EndianConvert(recordSize);
+    for (uint32 i = 0; i < 5; ++i)
+        EndianConvert(header[i]);
 
-    if (fread(&stringSize, 4, 1, f) != 1)                   // String size
+    if (header[0] != 0x43424457)                            //'WDBC'
+    {
+        if (f)
+            fclose(f);
+        FreeData();
         return false;
+    }
 
-    EndianConvert(stringSize);
+    recordCount = header[1];                                // Number of records
+    fieldCount = header[2];                                 // Number of fields
+    recordSize = header[3];                                 // Size of a record
+    stringSize = header[4];                                 // String size
 
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
@@ -74,20 +96,91 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
             fieldsOffset[i] += 4;
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
-    stringTable = data + recordSize * recordCount;
+    size_t dataSize = size_t(recordSize) * recordCount + stringSize;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-        return false;
+    if (fileMap)
+    {
+        if (fileMap->size() < sizeof(header) + dataSize)   // truncated file
+        {
+            FreeData();
+            return false;
+        }
+
+        data = (unsigned char*)fileMap->addr() + sizeof(header);
+    }
+    else
+    {
+        data = new unsigned char[dataSize];
+
+        bool readOk = fread(data, dataSize, 1, f) == 1;
+        fclose(f);
 
-    fclose(f);
+        if (!readOk)
+        {
+            FreeData();
+            return false;
+        }
+    }
+
+    stringTable = data + size_t(recordSize) * recordCount;
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
+    FreeData();
+}
+
+void DBCFileLoader::FreeData()
+{
+    if (fileMap)
+    {
+        delete fileMap;                                     // unmaps the file
+        fileMap = NULL;
+    }
+    else
+        delete[] data;
+
+    data = NULL;
+    stringTable = NULL;
+
     delete[] fieldsOffset;
+    fieldsOffset = NULL;
+}
+
+int32 DBCFileLoader::GetDirectRecordOffset(const char* format) const
+{
+#if MANGOS_ENDIAN == MANGOS_LITTLEENDIAN
+    // struct fields must be one run of 4 byte file fields, skipped fields are allowed only around it
+    int32 firstField = -1;
+    bool runEnded = false;
+
+    for (uint32 x = 0; x < fieldCount; ++x)
+    {
+        switch (format[x])
+        {
+            case FT_FLOAT:
+            case FT_INT:
+            case FT_IND:
+                if (runEnded)
+                    return -1;
+                if (firstField < 0)
+                    firstField = x;
+                break;
+            case FT_NA:
+            case FT_SORT:
+                if (firstField >= 0)
+                    runEnded = true;
+                break;
+            default:                                        // strings and byte fields need conversion
+                return -1;
+        }
+    }
+
+    return firstField >= 0 ? int32(GetOffset(firstField)) : -1;
+#else
+    return -1;                                              // file data is little endian
+#endif
 }
 
 DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
@@ -193,6 +286,19 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
         indexTable = new ptr[recordCount];
     }
 
+    int32 directOffset = GetDirectRecordOffset(format);
+    if (directOffset >= 0)
+    {
+        // file records already have the struct layout, point at them instead of copying
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            char* record = (char*)(data + size_t(y) * recordSize + directOffset);
+            indexTable[i >= 0 ? getRecord(y).getUInt(i) : y] = record;
+        }
+
+        return NULL;
+    }
+
     char* dataTable = new char[recordCount * recordsize];
 
     uint32 offset = 0;
@@ -305,17 +411,14 @@ char* DBCFileLoader::AutoProduceStringsArrayHolders(const char* format, char* da
     return stringHoldersPool;
 }
 
-char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable, LocaleConstant loc)
+bool DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable, LocaleConstant loc)
 {
     if (strlen(format) != fieldCount)
-        return NULL;
+        return false;
 
     // each string field at load have array of string for each locale
     size_t stringHolderSize = sizeof(char*) * MAX_LOCALE;
 
-    char* stringPool= new char[stringSize];
-    memcpy(stringPool,stringTable,stringSize);
-
     uint32 offset = 0;
 
     for (uint32 y = 0; y < recordCount; ++y)
@@ -342,8 +445,8 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable, Loc
                     // fill only not filled entries
                     if (*slot == nullStr)
                     {
-                        const char* st = getRecord(y).getString(x);
-                        *slot = stringPool + (st - (const char*)stringTable);
+                        // no copy, the store keeps the loader and so the file data alive
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
                     }
 
                     offset+=sizeof(char*);
@@ -363,5 +466,5 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable, Loc
         }
     }
 
-    return stringPool;
+    return true;
 }
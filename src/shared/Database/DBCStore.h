@@ -25,6 +25,7 @@ template<class T>
 class DBCStorage
 {
         typedef std::list<char*> StringPoolList;
+        typedef std::list<DBCFileLoader*> FileLoaderList;
     public:
         explicit DBCStorage(const char* f) : nCount(0), fieldCount(0), fmt(f), indexTable(NULL), m_dataTable(NULL) { }
         ~DBCStorage() { Clear(); }
@@ -36,21 +37,27 @@ class DBCStorage
 
         bool Load(char const* fn, LocaleConstant loc)
         {
-            DBCFileLoader dbc;
+            DBCFileLoader* dbc = new DBCFileLoader;
             // Check if load was sucessful, only then continue
-            if (!dbc.Load(fn, fmt))
+            if (!dbc->Load(fn, fmt))
+            {
+                delete dbc;
                 return false;
+            }
+
+            // records and strings may be used in place, keep the (mapped) file data with the store
+            m_fileList.push_back(dbc);
 
-            fieldCount = dbc.GetCols();
+            fieldCount = dbc->GetCols();
 
-            // load raw non-string data
-            m_dataTable = (T*)dbc.AutoProduceData(fmt, nCount, (char**&)indexTable);
+            // load raw non-string data, stays NULL if the records are used in place
+            m_dataTable = (T*)dbc->AutoProduceData(fmt, nCount, (char**&)indexTable);
 
             // create string holders for loaded string fields
-            m_stringPoolList.push_back(dbc.AutoProduceStringsArrayHolders(fmt,(char*)m_dataTable));
+            m_stringPoolList.push_back(dbc->AutoProduceStringsArrayHolders(fmt,(char*)m_dataTable));
 
             // load strings from dbc data
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt,(char*)m_dataTable,loc));
+            dbc->AutoProduceStrings(fmt,(char*)m_dataTable,loc);
 
             // error in dbc file at loading if NULL
             return indexTable != NULL;
@@ -62,19 +69,27 @@ class DBCStorage
             if (!indexTable)
                 return false;
 
-            DBCFileLoader dbc;
+            DBCFileLoader* dbc = new DBCFileLoader;
             // Check if load was successful, only then continue
-            if (!dbc.Load(fn, fmt))
+            // and load strings from another locale dbc data
+            if (!dbc->Load(fn, fmt) || !dbc->AutoProduceStrings(fmt,(char*)m_dataTable,loc))
+            {
+                delete dbc;
                 return false;
+            }
 
-            // load strings from another locale dbc data
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt,(char*)m_dataTable,loc));
-
+            m_fileList.push_back(dbc);
             return true;
         }
 
         void Clear()
         {
+            while (!m_fileList.empty())
+            {
+                delete m_fileList.front();
+                m_fileList.pop_front();
+            }
+
             if (!indexTable)
                 return;
 
@@ -101,6 +116,7 @@ class DBCStorage
         T** indexTable;
         T* m_dataTable;
         StringPoolList m_stringPoolList;
+        FileLoaderList m_fileList;
 };
 
 #endif
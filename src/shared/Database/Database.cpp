@@ -96,7 +96,7 @@ Database::~Database()
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nAsyncConns /*= 1*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -133,10 +133,33 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
         m_pQueryConnections.push_back(pConn);
     }
 
-    // create and initialize connection for async requests
-    m_pAsyncConn = CreateConnection();
-    if (!m_pAsyncConn->Initialize(infoString))
+    m_pStreamConn = CreateConnection();
+    if (!m_pStreamConn->Initialize(infoString))
+    {
+        delete m_pStreamConn;
+        m_pStreamConn = NULL;
         return false;
+    }
+
+    // create and initialize connections for async requests, one per worker
+    if (nAsyncConns < MIN_CONNECTION_POOL_SIZE)
+        nAsyncConns = MIN_CONNECTION_POOL_SIZE;
+    else if (nAsyncConns > MAX_CONNECTION_POOL_SIZE)
+        nAsyncConns = MAX_CONNECTION_POOL_SIZE;
+
+    for (int i = 0; i < nAsyncConns; ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pAsyncConns.push_back(pConn);
+    }
+
+    m_pAsyncConn = m_pAsyncConns[0];
 
     m_pResultQueue = new SqlResultQueue;
 
@@ -148,8 +171,13 @@ void Database::StopServer()
 {
     HaltDelayThread();
 
-    delete m_pResultQueue;
-    delete m_pAsyncConn;
+    if (m_pResultQueue)
+        m_pResultQueue->Close();
+
+    for (size_t i = 0; i < m_pAsyncConns.size(); ++i)
+        delete m_pAsyncConns[i];
+
+    m_pAsyncConns.clear();
 
     m_pResultQueue = NULL;
     m_pAsyncConn = NULL;
@@ -158,32 +186,134 @@ void Database::StopServer()
         delete m_pQueryConnections[i];
 
     m_pQueryConnections.clear();
+
+    delete m_pStreamConn;
+    m_pStreamConn = NULL;
 }
 
-SqlDelayThread* Database::CreateDelayThread()
+SqlDelayThread* Database::CreateDelayThread(SqlConnection* conn, bool pingDatabase)
 {
-    assert(m_pAsyncConn);
-    return new SqlDelayThread(this, m_pAsyncConn);
+    assert(conn);
+    return new SqlDelayThread(this, conn, pingDatabase);
 }
 
 void Database::InitDelayThread()
 {
-    assert(!m_delayThread);
+    assert(m_delayThreads.empty());
 
-    // New delay thread for delay execute
-    m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
-    m_delayThread = new ACE_Based::Thread(m_threadBody);
+    // New delay thread for delay execute, one per async connection
+    for (size_t i = 0; i < m_pAsyncConns.size(); ++i)
+    {
+        SqlDelayThread* threadBody = CreateDelayThread(m_pAsyncConns[i], i == 0);
+        m_threadBodies.push_back(threadBody);       // will deleted at thread delete
+        m_delayThreads.push_back(new ACE_Based::Thread(threadBody));
+    }
+
+    m_delayThreadsStopped = false;
 }
 
 void Database::HaltDelayThread()
 {
-    if (!m_threadBody || !m_delayThread) return;
+    if (m_delayThreads.empty()) return;
+
+    {
+        // no request without shard key may reach only a part of the workers
+        ACE_Guard<ACE_Thread_Mutex> guard(m_delayGuard);
+
+        m_delayThreadsStopped = true;
+        for (size_t i = 0; i < m_threadBodies.size(); ++i)
+            m_threadBodies[i]->Stop();                      // Stop event
+    }
+
+    for (size_t i = 0; i < m_delayThreads.size(); ++i)
+    {
+        m_delayThreads[i]->wait();                          // Wait for flush to DB
+        delete m_delayThreads[i];                           // This also deletes the thread body
+    }
+
+    m_delayThreads.clear();
+    m_threadBodies.clear();
+}
+
+bool Database::Delay(SqlOperation* sql, uint32 shardKey)
+{
+    size_t workers = m_threadBodies.size();
+
+    // keyed requests only need the order of their own worker
+    if (workers == 1 || (workers && shardKey))
+    {
+        if (m_threadBodies[shardKey % workers]->Delay(sql))
+            return true;
+    }
+    else if (workers)
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_delayGuard);
+
+        // workers are stopped under the same lock, so all of them get the barrier or none
+        if (!m_delayThreadsStopped)
+        {
+            SqlDelayBarrier* barrier = new SqlDelayBarrier(sql, workers);
+            for (size_t i = 0; i < workers; ++i)
+                m_threadBodies[i]->Delay(barrier);
+
+            return true;
+        }
+    }
+
+    // workers already stopped, execute in the calling thread
+    sql->Execute(m_pAsyncConn);
+    delete sql;
+    return true;
+}
+
+void Database::GetAsyncStats(SqlDelayStats& stats)
+{
+    for (size_t i = 0; i < m_threadBodies.size(); ++i)
+        m_threadBodies[i]->GetStats(stats);
+}
+
+static bool SqlOperationExecTimeGreater(SqlOperationProfileList::value_type const& a, SqlOperationProfileList::value_type const& b)
+{
+    return a.second.execTime > b.second.execTime;
+}
+
+void Database::GetOperationProfile(SqlOperationProfileList& profile, uint32 limit)
+{
+    SqlOperationProfile merged;
+    for (size_t i = 0; i < m_threadBodies.size(); ++i)
+        m_threadBodies[i]->GetProfile(merged);
 
-    m_threadBody->Stop();                                   // Stop event
-    m_delayThread->wait();                                  // Wait for flush to DB
-    delete m_delayThread;                                   // This also deletes m_threadBody
-    m_delayThread = NULL;
-    m_threadBody = NULL;
+    profile.assign(merged.begin(), merged.end());
+    std::sort(profile.begin(), profile.end(), SqlOperationExecTimeGreater);
+
+    if (limit && profile.size() > limit)
+        profile.resize(limit);
+}
+
+void Database::ResetOperationProfile()
+{
+    for (size_t i = 0; i < m_threadBodies.size(); ++i)
+        m_threadBodies[i]->ResetProfile();
+}
+
+void Database::LogOperationProfile(char const* name, uint32 limit)
+{
+    SqlOperationProfileList profile;
+    GetOperationProfile(profile, limit);
+
+    if (profile.empty())
+        return;
+
+    sLog.outString("%s database, slowest async statements:", name);
+
+    for (SqlOperationProfileList::const_iterator itr = profile.begin(); itr != profile.end(); ++itr)
+    {
+        SqlOperationStats const& stats = itr->second;
+        sLog.outString("  " UI64FMTD " ms total, " UI64FMTD " x, avg " UI64FMTD " us, max " UI64FMTD " us, wait avg " UI64FMTD " us, " UI64FMTD " rows: %s",
+                       stats.execTime / 1000, stats.count, stats.execTime / stats.count, stats.maxExecTime,
+                       stats.waitTime / stats.count, stats.rows, itr->first.c_str());
+        sLog.outString("    latency (ms):%s", SqlDelayStats::FormatHistogram(stats.latency).c_str());
+    }
 }
 
 void Database::ThreadStart()
@@ -228,8 +358,9 @@ void Database::Ping()
 {
     const char* sql = "SELECT 1";
 
+    for (size_t i = 0; i < m_pAsyncConns.size(); ++i)
     {
-        SqlConnection::Lock guard(m_pAsyncConn);
+        SqlConnection::Lock guard(m_pAsyncConns[i]);
         delete guard->Query(sql);
     }
 
@@ -238,6 +369,9 @@ void Database::Ping()
         SqlConnection::Lock guard(m_pQueryConnections[i]);
         delete guard->Query(sql);
     }
+
+    SqlConnection::Lock guard(m_pStreamConn);
+    delete guard->Query(sql);
 }
 
 bool Database::PExecuteLog(const char* format, ...)
@@ -322,6 +456,44 @@ QueryNamedResult* Database::PQueryNamed(const char* format, ...)
     return QueryNamed(szQuery);
 }
 
+QueryResult* Database::PBinaryQuery(const char* format, ...)
+{
+    if (!format) return NULL;
+
+    va_list ap;
+    char szQuery [MAX_QUERY_LEN];
+    va_start(ap, format);
+    int res = vsnprintf(szQuery, MAX_QUERY_LEN, format, ap);
+    va_end(ap);
+
+    if (res == -1)
+    {
+        sLog.outError("SQL Query truncated (and not execute) for format: %s", format);
+        return NULL;
+    }
+
+    return BinaryQuery(szQuery);
+}
+
+QueryResult* Database::PStreamQuery(const char* format, ...)
+{
+    if (!format) return NULL;
+
+    va_list ap;
+    char szQuery [MAX_QUERY_LEN];
+    va_start(ap, format);
+    int res = vsnprintf(szQuery, MAX_QUERY_LEN, format, ap);
+    va_end(ap);
+
+    if (res == -1)
+    {
+        sLog.outError("SQL Query truncated (and not execute) for format: %s", format);
+        return NULL;
+    }
+
+    return StreamQuery(szQuery);
+}
+
 bool Database::Execute(const char* sql)
 {
     if (!m_pAsyncConn)
@@ -340,7 +512,7 @@ bool Database::Execute(const char* sql)
             return DirectExecute(sql);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPlainRequest(sql));
+        Delay(new SqlPlainRequest(sql));
     }
 
     return true;
@@ -386,14 +558,14 @@ bool Database::DirectPExecute(const char* format, ...)
     return DirectExecute(szQuery);
 }
 
-bool Database::BeginTransaction()
+bool Database::BeginTransaction(uint32 shardKey)
 {
     if (!m_pAsyncConn)
         return false;
 
     // initiate transaction on current thread
     // currently we do not support queued transactions
-    m_TransStorage->init();
+    m_TransStorage->init(shardKey);
     return true;
 }
 
@@ -411,8 +583,8 @@ bool Database::CommitTransaction()
         return CommitTransactionDirect();
 
     // add SqlTransaction to the async queue
-    m_threadBody->Delay(m_TransStorage->detach());
-    return true;
+    uint32 shardKey = m_TransStorage->shardKey();
+    return Delay(m_TransStorage->detach(), shardKey);
 }
 
 bool Database::CommitTransactionDirect()
@@ -552,7 +724,7 @@ bool Database::ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params)
             return DirectExecuteStmt(id, params);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPreparedRequest(id.ID(), params));
+        Delay(new SqlPreparedRequest(id.ID(), params));
     }
 
     return true;
@@ -584,6 +756,7 @@ SqlStatement Database::CreateStatement(SqlStatementID& index, const char* fmt)
         {
             nId = ++m_iStmtIndex;
             m_stmtRegistry[szFmt] = nId;
+            m_stmtStrings.push_back(szFmt);
         }
         else
             nId = iter->second;
@@ -599,17 +772,10 @@ std::string Database::GetStmtString(const int stmtId) const
 {
     LOCK_GUARD _guard(m_stmtGuard);
 
-    if (stmtId == -1 || stmtId > m_iStmtIndex)
+    if (stmtId < 0 || stmtId > m_iStmtIndex)
         return std::string();
 
-    PreparedStmtRegistry::const_iterator iter_last = m_stmtRegistry.end();
-    for (PreparedStmtRegistry::const_iterator iter = m_stmtRegistry.begin(); iter != iter_last; ++iter)
-    {
-        if (iter->second == stmtId)
-            return iter->first;
-    }
-
-    return std::string();
+    return m_stmtStrings[stmtId];
 }
 
 // HELPER CLASSES AND FUNCTIONS
@@ -618,10 +784,11 @@ Database::TransHelper::~TransHelper()
     reset();
 }
 
-SqlTransaction* Database::TransHelper::init()
+SqlTransaction* Database::TransHelper::init(uint32 shardKey)
 {
     MANGOS_ASSERT(!m_pTrans);   // if we will get a nested transaction request - we MUST fix code!!!
     m_pTrans = new SqlTransaction;
+    m_shardKey = shardKey;
     return m_pTrans;
 }
 
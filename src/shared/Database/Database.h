@@ -28,6 +28,7 @@
 #include <ace/Atomic_Op.h>
 #include "SqlPreparedStatement.h"
 
+class SqlOperation;
 class SqlTransaction;
 class SqlResultQueue;
 class SqlQueryHolder;
@@ -48,6 +49,11 @@ class MANGOS_DLL_SPEC SqlConnection
         // public methods for making queries
         virtual QueryResult* Query(const char* sql) = 0;
         virtual QueryNamedResult* QueryNamed(const char* sql) = 0;
+        // query with typed result values decoded once, falls back to Query() if the DBMS has no binary protocol
+        virtual QueryResult* BinaryQuery(const char* sql) { return Query(sql); }
+        // like BinaryQuery(), but rows are fetched from the server while the result is read,
+        // the connection stays locked by the result until its last row was read or it is deleted
+        virtual QueryResult* StreamQuery(const char* sql) { return BinaryQuery(sql); }
 
         // public methods for making requests
         virtual bool Execute(const char* sql) = 0;
@@ -105,10 +111,10 @@ class MANGOS_DLL_SPEC Database
     public:
         virtual ~Database();
 
-        virtual bool Initialize(const char* infoString, int nConns = 1);
-        // start worker thread for async DB request execution
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nAsyncConns = 1);
+        // start worker threads for async DB request execution
         virtual void InitDelayThread();
-        // stop worker thread
+        // stop worker threads, they finish all queued requests first
         virtual void HaltDelayThread();
 
         /// Synchronous DB queries
@@ -124,8 +130,29 @@ class MANGOS_DLL_SPEC Database
             return guard->QueryNamed(sql);
         }
 
+        // same result interface as Query(), but numeric fields are decoded once at fetch time
+        // instead of being parsed from text at every Field access, intended for big load queries
+        inline QueryResult* BinaryQuery(const char* sql)
+        {
+            SqlConnection::Lock guard(getQueryConnection());
+            return guard->BinaryQuery(sql);
+        }
+
+        // same as BinaryQuery(), but only the current row is held in client memory, meant for the
+        // biggest startup tables. GetRowCount() is 0 (unknown). Streams run on their own connection,
+        // which stays blocked for other streams until the result is done, so the read loop must not
+        // start another stream. After the loop IsIncomplete() tells whether a fetch error ended
+        // it early. The result must be read and deleted by the thread that started the query.
+        inline QueryResult* StreamQuery(const char* sql)
+        {
+            SqlConnection::Lock guard(m_pStreamConn);
+            return guard->StreamQuery(sql);
+        }
+
         QueryResult* PQuery(const char* format, ...) ATTR_PRINTF(2, 3);
         QueryNamedResult* PQueryNamed(const char* format, ...) ATTR_PRINTF(2, 3);
+        QueryResult* PBinaryQuery(const char* format, ...) ATTR_PRINTF(2, 3);
+        QueryResult* PStreamQuery(const char* format, ...) ATTR_PRINTF(2, 3);
 
         inline bool DirectExecute(const char* sql)
         {
@@ -172,6 +199,23 @@ class MANGOS_DLL_SPEC Database
         bool AsyncPQuery(void (*method)(QueryResult*, ParamType1, ParamType2), ParamType1 param1, ParamType2 param2, const char* format, ...) ATTR_PRINTF(5, 6);
         template<typename ParamType1, typename ParamType2, typename ParamType3>
         bool AsyncPQuery(void (*method)(QueryResult*, ParamType1, ParamType2, ParamType3), ParamType1 param1, ParamType2 param2, ParamType3 param3, const char* format, ...) ATTR_PRINTF(6, 7);
+        // Query / member, callback executed by the owner of the queue (map or session update),
+        // the callback may start the next query of a chain with the same queue
+        template<class Class>
+        bool AsyncQuery(SqlResultQueue* queue, Class* object, void (Class::*method)(QueryResult*), const char* sql);
+        template<class Class, typename ParamType1>
+        bool AsyncQuery(SqlResultQueue* queue, Class* object, void (Class::*method)(QueryResult*, ParamType1), ParamType1 param1, const char* sql);
+        template<class Class, typename ParamType1, typename ParamType2>
+        bool AsyncQuery(SqlResultQueue* queue, Class* object, void (Class::*method)(QueryResult*, ParamType1, ParamType2), ParamType1 param1, ParamType2 param2, const char* sql);
+        template<class Class, typename ParamType1, typename ParamType2, typename ParamType3>
+        bool AsyncQuery(SqlResultQueue* queue, Class* object, void (Class::*method)(QueryResult*, ParamType1, ParamType2, ParamType3), ParamType1 param1, ParamType2 param2, ParamType3 param3, const char* sql);
+        // PQuery / member, callback executed by the owner of the queue
+        template<class Class>
+        bool AsyncPQuery(SqlResultQueue* queue, Class* object, void (Class::*method)(QueryResult*), const char* format, ...) ATTR_PRINTF(5, 6);
+        template<class Class, typename ParamType1>
+        bool AsyncPQuery(SqlResultQueue* queue, Class* object, void (Class::*method)(QueryResult*, ParamType1), ParamType1 param1, const char* format, ...) ATTR_PRINTF(6, 7);
+        template<class Class, typename ParamType1, typename ParamType2>
+        bool AsyncPQuery(SqlResultQueue* queue, Class* object, void (Class::*method)(QueryResult*, ParamType1, ParamType2), ParamType1 param1, ParamType2 param2, const char* format, ...) ATTR_PRINTF(7, 8);
         template<class Class>
         // QueryHolder
         bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*), SqlQueryHolder* holder);
@@ -184,7 +228,10 @@ class MANGOS_DLL_SPEC Database
         // Writes SQL commands to a LOG file (see mangosd.conf "LogSQL")
         bool PExecuteLog(const char* format, ...) ATTR_PRINTF(2, 3);
 
-        bool BeginTransaction();
+        // transactions with the same non zero shard key are executed in order by the same async worker,
+        // transactions with different keys may run in parallel, all other async requests
+        // are ordered against everything queued before and after them
+        bool BeginTransaction(uint32 shardKey = 0);
         bool CommitTransaction();
         bool RollbackTransaction();
         // for sync transaction execution
@@ -216,6 +263,20 @@ class MANGOS_DLL_SPEC Database
         // function to ping database connections
         void Ping();
 
+        // queue async request for the worker selected by shardKey, see BeginTransaction
+        bool Delay(SqlOperation* sql, uint32 shardKey = 0);
+
+        // histograms of all async workers
+        void GetAsyncStats(SqlDelayStats& stats);
+        uint32 GetAsyncWorkerCount() const { return m_threadBodies.size(); }
+
+        // async operation profile of all workers since the last reset, most execution time first,
+        // limit 0 returns all templates
+        void GetOperationProfile(SqlOperationProfileList& profile, uint32 limit);
+        void ResetOperationProfile();
+        // write the top templates of the profile to the server log
+        void LogOperationProfile(char const* name, uint32 limit);
+
         // set this to allow async transactions
         // you should call it explicitly after your server successfully started up
         // NO ASYNC TRANSACTIONS DURING SERVER STARTUP - ONLY DURING RUNTIME!!!
@@ -223,8 +284,8 @@ class MANGOS_DLL_SPEC Database
 
     protected:
         Database() :
-            m_nQueryConnPoolSize(1), m_pAsyncConn(NULL), m_pResultQueue(NULL),
-            m_threadBody(NULL), m_delayThread(NULL), m_bAllowAsyncTransactions(false),
+            m_nQueryConnPoolSize(1), m_pStreamConn(NULL), m_pAsyncConn(NULL), m_pResultQueue(NULL),
+            m_delayThreadsStopped(true), m_bAllowAsyncTransactions(false),
             m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
         {
             m_nQueryCounter = -1;
@@ -235,18 +296,20 @@ class MANGOS_DLL_SPEC Database
         // factory method to create SqlConnection objects
         virtual SqlConnection* CreateConnection() = 0;
         // factory method to create SqlDelayThread objects
-        virtual SqlDelayThread* CreateDelayThread();
+        virtual SqlDelayThread* CreateDelayThread(SqlConnection* conn, bool pingDatabase);
 
         class MANGOS_DLL_SPEC TransHelper
         {
             public:
-                TransHelper() : m_pTrans(NULL) {}
+                TransHelper() : m_pTrans(NULL), m_shardKey(0) {}
                 ~TransHelper();
 
                 // initializes new SqlTransaction object
-                SqlTransaction* init();
+                SqlTransaction* init(uint32 shardKey);
                 // gets pointer on current transaction object. Returns NULL if transaction was not initiated
                 SqlTransaction* get() const { return m_pTrans; }
+                // shard key given to init()
+                uint32 shardKey() const { return m_shardKey; }
                 // detaches SqlTransaction object allocated by init() function
                 // next call to get() function will return NULL!
                 // do not forget to destroy obtained SqlTransaction object!
@@ -256,6 +319,7 @@ class MANGOS_DLL_SPEC Database
 
             private:
                 SqlTransaction* m_pTrans;
+                uint32 m_shardKey;
         };
 
         // per-thread based storage for SqlTransaction object initialization - no locking is required
@@ -282,13 +346,23 @@ class MANGOS_DLL_SPEC Database
         // lets use pool of connections for sync queries
         typedef std::vector< SqlConnection* > SqlConnectionContainer;
         SqlConnectionContainer m_pQueryConnections;
+        // streamed results keep their connection locked for the whole read, not one of the pool
+        SqlConnection* m_pStreamConn;
 
-        // only one single DB connection for transactions
+        // connection of the first async worker, also used for direct execution
         SqlConnection* m_pAsyncConn;
+        // one connection per async worker, m_pAsyncConn is the first
+        SqlConnectionContainer m_pAsyncConns;
 
         SqlResultQueue*     m_pResultQueue;                 ///< Transaction queues from diff. threads
-        SqlDelayThread*     m_threadBody;                   ///< Pointer to delay sql executer (owned by m_delayThread)
-        ACE_Based::Thread* m_delayThread;                   ///< Pointer to executer thread
+
+        typedef std::vector<SqlDelayThread*> SqlDelayThreadContainer;
+        typedef std::vector<ACE_Based::Thread*> DelayThreadContainer;
+        SqlDelayThreadContainer m_threadBodies;             ///< Async workers (owned by m_delayThreads)
+        DelayThreadContainer m_delayThreads;                ///< Executer threads of the async workers
+
+        ACE_Thread_Mutex m_delayGuard;                      ///< Keeps requests without shard key in the same order on all workers
+        bool m_delayThreadsStopped;
 
         bool m_bAllowAsyncTransactions;                     ///< flag which specifies if async transactions are enabled
 
@@ -300,6 +374,7 @@ class MANGOS_DLL_SPEC Database
 
         typedef UNORDERED_MAP<std::string, int> PreparedStmtRegistry;
         PreparedStmtRegistry m_stmtRegistry;                ///<
+        std::vector<std::string> m_stmtStrings;             ///< Format strings by statement ID
 
         int m_iStmtIndex;
 
@@ -309,4 +384,36 @@ class MANGOS_DLL_SPEC Database
         std::string m_logsDir;
         uint32 m_pingIntervallms;
 };
+
+/**
+ * Dependent async queries of one object, executed one after another through the same result queue.
+ *
+ * Every step gets a copy of the chain and starts the next query through it, so all steps run in the
+ * thread draining the queue and none of them blocks on the database. Implemented in DatabaseImpl.h
+ */
+template<class Class>
+class SqlQueryChain
+{
+    public:
+        SqlQueryChain(Database& db, SqlResultQueue* queue, Class* object) : m_db(&db), m_queue(queue), m_object(object) {}
+
+        bool Query(void (Class::*step)(QueryResult*, SqlQueryChain<Class>), const char* sql);
+        template<typename ParamType1>
+        bool Query(void (Class::*step)(QueryResult*, SqlQueryChain<Class>, ParamType1), ParamType1 param1, const char* sql);
+        template<typename ParamType1, typename ParamType2>
+        bool Query(void (Class::*step)(QueryResult*, SqlQueryChain<Class>, ParamType1, ParamType2), ParamType1 param1, ParamType2 param2, const char* sql);
+
+        bool PQuery(void (Class::*step)(QueryResult*, SqlQueryChain<Class>), const char* format, ...) ATTR_PRINTF(3, 4);
+        template<typename ParamType1>
+        bool PQuery(void (Class::*step)(QueryResult*, SqlQueryChain<Class>, ParamType1), ParamType1 param1, const char* format, ...) ATTR_PRINTF(4, 5);
+        template<typename ParamType1, typename ParamType2>
+        bool PQuery(void (Class::*step)(QueryResult*, SqlQueryChain<Class>, ParamType1, ParamType2), ParamType1 param1, ParamType2 param2, const char* format, ...) ATTR_PRINTF(5, 6);
+
+        Database& DB() const { return *m_db; }
+
+    private:
+        Database* m_db;
+        SqlResultQueue* m_queue;
+        Class* m_object;
+};
 #endif
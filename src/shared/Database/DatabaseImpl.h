@@ -22,6 +22,7 @@
 /// Function body definitions for the template function members of the Database class
 
 #define ASYNC_QUERY_BODY(sql) if (!sql || !m_pResultQueue) return false;
+#define ASYNC_QUEUE_QUERY_BODY(sql, queue) if (!sql || !queue) return false;
 #define ASYNC_DELAYHOLDER_BODY(holder) if (!holder || !m_pResultQueue) return false;
 
 #define ASYNC_PQUERY_BODY(format, szQuery) \
@@ -50,7 +51,7 @@ bool
 Database::AsyncQuery(Class* object, void (Class::*method)(QueryResult*), const char* sql)
 {
     ASYNC_QUERY_BODY(sql)
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback<Class>(object, method), m_pResultQueue));
+    return Delay(new SqlQuery(sql, new MaNGOS::QueryCallback<Class>(object, method, (QueryResult*)NULL), m_pResultQueue));
 }
 
 template<class Class, typename ParamType1>
@@ -58,7 +59,7 @@ bool
 Database::AsyncQuery(Class* object, void (Class::*method)(QueryResult*, ParamType1), ParamType1 param1, const char* sql)
 {
     ASYNC_QUERY_BODY(sql)
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback<Class, ParamType1>(object, method, (QueryResult*)NULL, param1), m_pResultQueue));
+    return Delay(new SqlQuery(sql, new MaNGOS::QueryCallback<Class, ParamType1>(object, method, (QueryResult*)NULL, param1), m_pResultQueue));
 }
 
 template<class Class, typename ParamType1, typename ParamType2>
@@ -66,7 +67,7 @@ bool
 Database::AsyncQuery(Class* object, void (Class::*method)(QueryResult*, ParamType1, ParamType2), ParamType1 param1, ParamType2 param2, const char* sql)
 {
     ASYNC_QUERY_BODY(sql)
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback<Class, ParamType1, ParamType2>(object, method, (QueryResult*)NULL, param1, param2), m_pResultQueue));
+    return Delay(new SqlQuery(sql, new MaNGOS::QueryCallback<Class, ParamType1, ParamType2>(object, method, (QueryResult*)NULL, param1, param2), m_pResultQueue));
 }
 
 template<class Class, typename ParamType1, typename ParamType2, typename ParamType3>
@@ -74,7 +75,7 @@ bool
 Database::AsyncQuery(Class* object, void (Class::*method)(QueryResult*, ParamType1, ParamType2, ParamType3), ParamType1 param1, ParamType2 param2, ParamType3 param3, const char* sql)
 {
     ASYNC_QUERY_BODY(sql)
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::QueryCallback<Class, ParamType1, ParamType2, ParamType3>(object, method, (QueryResult*)NULL, param1, param2, param3), m_pResultQueue));
+    return Delay(new SqlQuery(sql, new MaNGOS::QueryCallback<Class, ParamType1, ParamType2, ParamType3>(object, method, (QueryResult*)NULL, param1, param2, param3), m_pResultQueue));
 }
 
 // -- Query / static --
@@ -84,7 +85,7 @@ bool
 Database::AsyncQuery(void (*method)(QueryResult*, ParamType1), ParamType1 param1, const char* sql)
 {
     ASYNC_QUERY_BODY(sql)
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::SQueryCallback<ParamType1>(method, (QueryResult*)NULL, param1), m_pResultQueue));
+    return Delay(new SqlQuery(sql, new MaNGOS::SQueryCallback<ParamType1>(method, (QueryResult*)NULL, param1), m_pResultQueue));
 }
 
 template<typename ParamType1, typename ParamType2>
@@ -92,7 +93,7 @@ bool
 Database::AsyncQuery(void (*method)(QueryResult*, ParamType1, ParamType2), ParamType1 param1, ParamType2 param2, const char* sql)
 {
     ASYNC_QUERY_BODY(sql)
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::SQueryCallback<ParamType1, ParamType2>(method, (QueryResult*)NULL, param1, param2), m_pResultQueue));
+    return Delay(new SqlQuery(sql, new MaNGOS::SQueryCallback<ParamType1, ParamType2>(method, (QueryResult*)NULL, param1, param2), m_pResultQueue));
 }
 
 template<typename ParamType1, typename ParamType2, typename ParamType3>
@@ -100,7 +101,7 @@ bool
 Database::AsyncQuery(void (*method)(QueryResult*, ParamType1, ParamType2, ParamType3), ParamType1 param1, ParamType2 param2, ParamType3 param3, const char* sql)
 {
     ASYNC_QUERY_BODY(sql)
-    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::SQueryCallback<ParamType1, ParamType2, ParamType3>(method, (QueryResult*)NULL, param1, param2, param3), m_pResultQueue));
+    return Delay(new SqlQuery(sql, new MaNGOS::SQueryCallback<ParamType1, ParamType2, ParamType3>(method, (QueryResult*)NULL, param1, param2, param3), m_pResultQueue));
 }
 
 // -- PQuery / member --
@@ -163,6 +164,66 @@ Database::AsyncPQuery(void (*method)(QueryResult*, ParamType1, ParamType2, Param
     return AsyncQuery(method, param1, param2, param3, szQuery);
 }
 
+// -- Query / member, owner queue --
+
+template<class Class>
+bool
+Database::AsyncQuery(SqlResultQueue* queue, Class* object, void (Class::*method)(QueryResult*), const char* sql)
+{
+    ASYNC_QUEUE_QUERY_BODY(sql, queue)
+    return Delay(new SqlQuery(sql, new MaNGOS::QueryCallback<Class>(object, method, (QueryResult*)NULL), queue));
+}
+
+template<class Class, typename ParamType1>
+bool
+Database::AsyncQuery(SqlResultQueue* queue, Class* object, void (Class::*method)(QueryResult*, ParamType1), ParamType1 param1, const char* sql)
+{
+    ASYNC_QUEUE_QUERY_BODY(sql, queue)
+    return Delay(new SqlQuery(sql, new MaNGOS::QueryCallback<Class, ParamType1>(object, method, (QueryResult*)NULL, param1), queue));
+}
+
+template<class Class, typename ParamType1, typename ParamType2>
+bool
+Database::AsyncQuery(SqlResultQueue* queue, Class* object, void (Class::*method)(QueryResult*, ParamType1, ParamType2), ParamType1 param1, ParamType2 param2, const char* sql)
+{
+    ASYNC_QUEUE_QUERY_BODY(sql, queue)
+    return Delay(new SqlQuery(sql, new MaNGOS::QueryCallback<Class, ParamType1, ParamType2>(object, method, (QueryResult*)NULL, param1, param2), queue));
+}
+
+template<class Class, typename ParamType1, typename ParamType2, typename ParamType3>
+bool
+Database::AsyncQuery(SqlResultQueue* queue, Class* object, void (Class::*method)(QueryResult*, ParamType1, ParamType2, ParamType3), ParamType1 param1, ParamType2 param2, ParamType3 param3, const char* sql)
+{
+    ASYNC_QUEUE_QUERY_BODY(sql, queue)
+    return Delay(new SqlQuery(sql, new MaNGOS::QueryCallback<Class, ParamType1, ParamType2, ParamType3>(object, method, (QueryResult*)NULL, param1, param2, param3), queue));
+}
+
+// -- PQuery / member, owner queue --
+
+template<class Class>
+bool
+Database::AsyncPQuery(SqlResultQueue* queue, Class* object, void (Class::*method)(QueryResult*), const char* format, ...)
+{
+    ASYNC_PQUERY_BODY(format, szQuery)
+    return AsyncQuery(queue, object, method, szQuery);
+}
+
+template<class Class, typename ParamType1>
+bool
+Database::AsyncPQuery(SqlResultQueue* queue, Class* object, void (Class::*method)(QueryResult*, ParamType1), ParamType1 param1, const char* format, ...)
+{
+    ASYNC_PQUERY_BODY(format, szQuery)
+    return AsyncQuery(queue, object, method, param1, szQuery);
+}
+
+template<class Class, typename ParamType1, typename ParamType2>
+bool
+Database::AsyncPQuery(SqlResultQueue* queue, Class* object, void (Class::*method)(QueryResult*, ParamType1, ParamType2), ParamType1 param1, ParamType2 param2, const char* format, ...)
+{
+    ASYNC_PQUERY_BODY(format, szQuery)
+    return AsyncQuery(queue, object, method, param1, param2, szQuery);
+}
+
 // -- QueryHolder --
 
 template<class Class>
@@ -170,7 +231,7 @@ bool
 Database::DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*), SqlQueryHolder* holder)
 {
     ASYNC_DELAYHOLDER_BODY(holder)
-    return holder->Execute(new MaNGOS::QueryCallback<Class, SqlQueryHolder*>(object, method, (QueryResult*)NULL, holder), m_threadBody, m_pResultQueue);
+    return holder->Execute(new SqlQueryHolderCallback<Class>(object, method, holder), this, m_pResultQueue);
 }
 
 template<class Class, typename ParamType1>
@@ -178,9 +239,61 @@ bool
 Database::DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*, ParamType1), SqlQueryHolder* holder, ParamType1 param1)
 {
     ASYNC_DELAYHOLDER_BODY(holder)
-    return holder->Execute(new MaNGOS::QueryCallback<Class, SqlQueryHolder*, ParamType1>(object, method, (QueryResult*)NULL, holder, param1), m_threadBody, m_pResultQueue);
+    return holder->Execute(new SqlQueryHolderCallback<Class, ParamType1>(object, method, holder, param1), this, m_pResultQueue);
+}
+
+// -- Query chain --
+
+template<class Class>
+bool
+SqlQueryChain<Class>::Query(void (Class::*step)(QueryResult*, SqlQueryChain<Class>), const char* sql)
+{
+    return m_db->AsyncQuery(m_queue, m_object, step, *this, sql);
+}
+
+template<class Class>
+template<typename ParamType1>
+bool
+SqlQueryChain<Class>::Query(void (Class::*step)(QueryResult*, SqlQueryChain<Class>, ParamType1), ParamType1 param1, const char* sql)
+{
+    return m_db->AsyncQuery(m_queue, m_object, step, *this, param1, sql);
+}
+
+template<class Class>
+template<typename ParamType1, typename ParamType2>
+bool
+SqlQueryChain<Class>::Query(void (Class::*step)(QueryResult*, SqlQueryChain<Class>, ParamType1, ParamType2), ParamType1 param1, ParamType2 param2, const char* sql)
+{
+    return m_db->AsyncQuery(m_queue, m_object, step, *this, param1, param2, sql);
+}
+
+template<class Class>
+bool
+SqlQueryChain<Class>::PQuery(void (Class::*step)(QueryResult*, SqlQueryChain<Class>), const char* format, ...)
+{
+    ASYNC_PQUERY_BODY(format, szQuery)
+    return Query(step, szQuery);
+}
+
+template<class Class>
+template<typename ParamType1>
+bool
+SqlQueryChain<Class>::PQuery(void (Class::*step)(QueryResult*, SqlQueryChain<Class>, ParamType1), ParamType1 param1, const char* format, ...)
+{
+    ASYNC_PQUERY_BODY(format, szQuery)
+    return Query(step, param1, szQuery);
+}
+
+template<class Class>
+template<typename ParamType1, typename ParamType2>
+bool
+SqlQueryChain<Class>::PQuery(void (Class::*step)(QueryResult*, SqlQueryChain<Class>, ParamType1, ParamType2), ParamType1 param1, ParamType2 param2, const char* format, ...)
+{
+    ASYNC_PQUERY_BODY(format, szQuery)
+    return Query(step, param1, param2, szQuery);
 }
 
 #undef ASYNC_QUERY_BODY
+#undef ASYNC_QUEUE_QUERY_BODY
 #undef ASYNC_PQUERY_BODY
 #undef ASYNC_DELAYHOLDER_BODY
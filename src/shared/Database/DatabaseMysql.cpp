@@ -245,6 +245,116 @@ QueryNamedResult* MySQLConnection::QueryNamed(const char* sql)
     return new QueryNamedResult(queryResult, names);
 }
 
+QueryResult* MySQLConnection::BinaryQuery(const char* sql)
+{
+    if (!mMysql)
+        return NULL;
+
+    uint32 _s = WorldTimer::getMSTime();
+
+    MYSQL_STMT* stmt = mysql_stmt_init(mMysql);
+    if (!stmt)
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("mysql_stmt_init() failed: %s", mysql_error(mMysql));
+        return NULL;
+    }
+
+    // let mysql_stmt_store_result() fill max_length, so text columns get fitting buffers
+    my_bool updateMaxLength = 1;
+    mysql_stmt_attr_set(stmt, STMT_ATTR_UPDATE_MAX_LENGTH, &updateMaxLength);
+
+    if (mysql_stmt_prepare(stmt, sql, strlen(sql)) || mysql_stmt_execute(stmt) || mysql_stmt_store_result(stmt))
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("query ERROR: %s", mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+        return NULL;
+    }
+
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s, WorldTimer::getMSTime()), sql);
+
+    QueryResult* queryResult = NULL;
+
+    uint64 rowCount = mysql_stmt_num_rows(stmt);
+    MYSQL_RES* metadata = mysql_stmt_result_metadata(stmt);
+    if (metadata)
+    {
+        uint32 fieldCount = mysql_num_fields(metadata);
+        if (rowCount && fieldCount)
+        {
+            QueryResultMysqlBinary* binaryResult = new QueryResultMysqlBinary(stmt, mysql_fetch_fields(metadata), rowCount, fieldCount);
+
+            // a part of the rows is no valid result, fail like Query() does on errors
+            if (binaryResult->IsIncomplete())
+            {
+                sLog.outErrorDb("SQL: %s", sql);
+                sLog.outErrorDb("query ERROR: only " UI64FMTD " of " UI64FMTD " rows could be fetched",
+                                binaryResult->GetFetchedRowCount(), binaryResult->GetStoredRowCount());
+                delete binaryResult;
+            }
+            // same as Query(): no result for empty sets, else positioned at the first row
+            else if (binaryResult->NextRow())
+                queryResult = binaryResult;
+            else
+                delete binaryResult;
+        }
+
+        mysql_free_result(metadata);
+    }
+
+    mysql_stmt_free_result(stmt);
+    mysql_stmt_close(stmt);
+    return queryResult;
+}
+
+QueryResult* MySQLConnection::StreamQuery(const char* sql)
+{
+    if (!mMysql)
+        return NULL;
+
+    uint32 _s = WorldTimer::getMSTime();
+
+    MYSQL_STMT* stmt = mysql_stmt_init(mMysql);
+    if (!stmt)
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("mysql_stmt_init() failed: %s", mysql_error(mMysql));
+        return NULL;
+    }
+
+    // no mysql_stmt_store_result(): rows stay at the server until mysql_stmt_fetch() reads them
+    if (mysql_stmt_prepare(stmt, sql, strlen(sql)) || mysql_stmt_execute(stmt))
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("query ERROR: %s", mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+        return NULL;
+    }
+
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s, WorldTimer::getMSTime()), sql);
+
+    MYSQL_RES* metadata = mysql_stmt_result_metadata(stmt);
+    if (!metadata || !mysql_num_fields(metadata))
+    {
+        if (metadata)
+            mysql_free_result(metadata);
+
+        mysql_stmt_close(stmt);
+        return NULL;
+    }
+
+    // the connection can't run anything else before all rows are read, the result holds its lock till then
+    QueryResultMysqlBinary* streamResult = new QueryResultMysqlBinary(stmt, metadata, mysql_num_fields(metadata), new SqlConnection::Lock(this));
+
+    // same as Query(): no result for empty sets, else positioned at the first row
+    if (streamResult->NextRow())
+        return streamResult;
+
+    delete streamResult;
+    return NULL;
+}
+
 bool MySQLConnection::Execute(const char* sql)
 {
     if (!mMysql)
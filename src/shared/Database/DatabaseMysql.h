@@ -78,6 +78,8 @@ class MANGOS_DLL_SPEC MySQLConnection : public SqlConnection
 
         QueryResult* Query(const char* sql) override;
         QueryNamedResult* QueryNamed(const char* sql) override;
+        QueryResult* BinaryQuery(const char* sql) override;
+        QueryResult* StreamQuery(const char* sql) override;
         bool Execute(const char* sql) override;
 
         unsigned long escape_string(char* to, const char* from, unsigned long length);
@@ -16,4 +16,24 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-//#include "DatabaseEnv.h"
+#include "Field.h"
+
+const char* Field::FormatBinaryValue() const
+{
+    switch (mBinaryType)
+    {
+        case BINARY_INT:
+            snprintf(mBinaryCell->text, sizeof(mBinaryCell->text), SI64FMTD, mBinaryCell->value.i64);
+            break;
+        case BINARY_UINT:
+            snprintf(mBinaryCell->text, sizeof(mBinaryCell->text), UI64FMTD, mBinaryCell->value.ui64);
+            break;
+        case BINARY_FLOAT:
+            snprintf(mBinaryCell->text, sizeof(mBinaryCell->text), "%.9g", mBinaryCell->value.f);
+            break;
+        default:
+            return mValue;
+    }
+
+    return mBinaryCell->text;
+}
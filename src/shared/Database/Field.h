@@ -34,28 +34,67 @@ class Field
             DB_TYPE_BOOL    = 0x04
         };
 
-        Field() : mValue(NULL), mType(DB_TYPE_UNKNOWN) {}
-        Field(const char* value, enum DataTypes type) : mValue(value), mType(type) {}
+        // value type of fields filled from a binary protocol result, see Database::BinaryQuery
+        enum BinaryTypes
+        {
+            BINARY_NONE     = 0x00,                         // text value (or NULL) in mValue
+            BINARY_INT      = 0x01,
+            BINARY_UINT     = 0x02,
+            BINARY_FLOAT    = 0x03
+        };
+
+        union BinaryValue
+        {
+            int64 i64;
+            uint64 ui64;
+            double f;
+        };
+
+        // binary value of the current row, owned by the result like the text values
+        struct BinaryCell
+        {
+            BinaryValue value;
+            mutable char text[32];                          // text form for GetString()
+        };
+
+        Field() : mValue(NULL), mType(DB_TYPE_UNKNOWN), mBinaryType(BINARY_NONE) {}
+        Field(const char* value, enum DataTypes type) : mValue(value), mType(type), mBinaryType(BINARY_NONE) {}
 
         ~Field() {}
 
         enum DataTypes GetType() const { return mType; }
-        bool IsNULL() const { return mValue == NULL; }
+        bool IsNULL() const { return mValue == NULL && mBinaryType == BINARY_NONE; }
 
-        const char* GetString() const { return mValue; }
+        const char* GetString() const { return mBinaryType != BINARY_NONE ? FormatBinaryValue() : mValue; }
         std::string GetCppString() const
         {
-            return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
+            const char* value = GetString();
+            return value ? value : "";                      // std::string s = 0 have undefine result in C++
         }
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
-        int32 GetInt32() const { return mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
-        int16 GetInt16() const { return mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(atol(mValue)) : uint32(0); }
+        float GetFloat() const
+        {
+            if (mBinaryType != BINARY_NONE)
+                return static_cast<float>(GetBinaryDouble());
+
+            return mValue ? static_cast<float>(atof(mValue)) : 0.0f;
+        }
+        bool GetBool() const
+        {
+            if (mBinaryType != BINARY_NONE)
+                return GetBinaryInt64() > 0;
+
+            return mValue ? atoi(mValue) > 0 : false;
+        }
+        int32 GetInt32() const { return mBinaryType != BINARY_NONE ? static_cast<int32>(GetBinaryInt64()) : mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
+        uint8 GetUInt8() const { return mBinaryType != BINARY_NONE ? static_cast<uint8>(GetBinaryInt64()) : mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
+        uint16 GetUInt16() const { return mBinaryType != BINARY_NONE ? static_cast<uint16>(GetBinaryInt64()) : mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
+        int16 GetInt16() const { return mBinaryType != BINARY_NONE ? static_cast<int16>(GetBinaryInt64()) : mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
+        uint32 GetUInt32() const { return mBinaryType != BINARY_NONE ? static_cast<uint32>(GetBinaryInt64()) : mValue ? static_cast<uint32>(atol(mValue)) : uint32(0); }
         uint64 GetUInt64() const
         {
+            if (mBinaryType != BINARY_NONE)
+                return static_cast<uint64>(GetBinaryInt64());
+
             uint64 value = 0;
             if (!mValue || sscanf(mValue, UI64FMTD, &value) == -1)
                 return 0;
@@ -66,13 +105,34 @@ class Field
         void SetType(enum DataTypes type) { mType = type; }
         // no need for memory allocations to store resultset field strings
         // all we need is to cache pointers returned by different DBMS APIs
-        void SetValue(const char* value) { mValue = value; };
+        void SetValue(const char* value) { mValue = value; mBinaryType = BINARY_NONE; }
+        // already decoded value of a binary protocol result
+        void SetBinaryValue(BinaryTypes type, BinaryCell const* cell) { mBinaryCell = cell; mBinaryType = type; }
 
     private:
         Field(Field const&);
         Field& operator=(Field const&);
 
-        const char* mValue;
+        // unsigned values keep their bits in i64, so casts to smaller types behave like for text values
+        int64 GetBinaryInt64() const { return mBinaryType == BINARY_FLOAT ? static_cast<int64>(mBinaryCell->value.f) : mBinaryCell->value.i64; }
+        double GetBinaryDouble() const
+        {
+            switch (mBinaryType)
+            {
+                case BINARY_INT:    return static_cast<double>(mBinaryCell->value.i64);
+                case BINARY_UINT:   return static_cast<double>(mBinaryCell->value.ui64);
+                default:            return mBinaryCell->value.f;
+            }
+        }
+        // text form of a binary value, only for callers that read numeric columns as strings
+        const char* FormatBinaryValue() const;
+
+        union
+        {
+            const char* mValue;
+            BinaryCell const* mBinaryCell;                  // if mBinaryType isn't BINARY_NONE
+        };
         enum DataTypes mType;
+        BinaryTypes mBinaryType;
 };
 #endif
@@ -24,7 +24,7 @@
 class PGSQLDelayThread : public SqlDelayThread
 {
     public:
-        PGSQLDelayThread(Database* db) : SqlDelayThread(db) {}
+        PGSQLDelayThread(Database* db, SqlConnection* conn, bool pingDatabase) : SqlDelayThread(db, conn, pingDatabase) {}
         void Stop() { SqlDelayThread::Stop() override; }
 };
 #endif                                                      //__PGSQLDELAYTHREAD_H
@@ -33,6 +33,9 @@ class MANGOS_DLL_SPEC QueryResult
 
         virtual bool NextRow() = 0;
 
+        // rows were lost to a fetch error, the data read from the result must not be used
+        virtual bool IsIncomplete() const { return false; }
+
         Field* Fetch() const { return mCurrentRow; }
 
         const Field& operator [](int index) const { return mCurrentRow[index]; }
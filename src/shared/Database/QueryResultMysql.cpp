@@ -68,7 +68,7 @@ void QueryResultMysql::EndQuery()
     }
 }
 
-enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType) const
+enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType)
 {
     switch (mysqlType)
     {
@@ -98,4 +98,227 @@ enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysql
             return Field::DB_TYPE_UNKNOWN;
     }
 }
+
+QueryResultMysqlBinary::QueryResultMysqlBinary(MYSQL_STMT* stmt, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount) :
+    QueryResult(rowCount, fieldCount), mNextRow(0), mStoredRows(rowCount), mFetchedRows(0), mFetchFailed(false), mStmt(stmt), mMetadata(NULL), mStreamLock(NULL)
+{
+    mCells.resize(size_t(rowCount) * mFieldCount);
+    mNulls.resize(size_t(rowCount) * mFieldCount);
+
+    BindColumns(fields, true);
+
+    uint64 row = 0;
+    for (; row < rowCount; ++row)
+        if (!FetchRow(size_t(row) * mFieldCount))
+            break;
+
+    mRowCount = row;
+    mFetchedRows = row;
+
+    // statement is closed by the caller, the binds are not needed anymore
+    mStmt = NULL;
+    std::vector<MYSQL_BIND>().swap(mBinds);
+    std::vector<std::vector<char> >().swap(mBuffers);
+}
+
+QueryResultMysqlBinary::QueryResultMysqlBinary(MYSQL_STMT* stmt, MYSQL_RES* metadata, uint32 fieldCount, SqlConnection::Lock* streamLock) :
+    QueryResult(0, fieldCount), mNextRow(0), mStoredRows(0), mFetchedRows(0), mFetchFailed(false), mStmt(stmt), mMetadata(metadata), mStreamLock(streamLock)
+{
+    mCells.resize(mFieldCount);
+    mNulls.resize(mFieldCount);
+
+    BindColumns(mysql_fetch_fields(metadata), false);
+}
+
+QueryResultMysqlBinary::~QueryResultMysqlBinary()
+{
+    EndQuery();
+}
+
+void QueryResultMysqlBinary::BindColumns(MYSQL_FIELD* fields, bool stored)
+{
+    mCurrentRow = new Field[mFieldCount];
+    MANGOS_ASSERT(mCurrentRow);
+
+    mColumnTypes.resize(mFieldCount);
+    mRowCells.resize(mFieldCount);
+    mBinds.resize(mFieldCount);
+    mValues.resize(mFieldCount);
+    mLengths.resize(mFieldCount);
+    mBindNulls.resize(mFieldCount);
+    mBuffers.resize(mFieldCount);
+
+    memset(&mBinds[0], 0, sizeof(MYSQL_BIND) * mFieldCount);
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        mCurrentRow[i].SetType(QueryResultMysql::ConvertNativeType(fields[i].type));
+        mColumnTypes[i] = ConvertBinaryType(fields[i]);
+
+        switch (mColumnTypes[i])
+        {
+            case Field::BINARY_INT:
+            case Field::BINARY_UINT:
+                mBinds[i].buffer_type = MYSQL_TYPE_LONGLONG;
+                mBinds[i].buffer = &mValues[i].i64;
+                mBinds[i].is_unsigned = mColumnTypes[i] == Field::BINARY_UINT;
+                break;
+            case Field::BINARY_FLOAT:
+                mBinds[i].buffer_type = MYSQL_TYPE_DOUBLE;
+                mBinds[i].buffer = &mValues[i].f;
+                break;
+            default:
+                // max_length is only filled by mysql_stmt_store_result, streamed columns start small
+                // and grow, longer values are refetched in FetchRow()
+                mBuffers[i].resize((stored ? fields[i].max_length : 64) + 1);
+                mBinds[i].buffer_type = MYSQL_TYPE_STRING;
+                mBinds[i].buffer = &mBuffers[i][0];
+                mBinds[i].buffer_length = mBuffers[i].size();
+                break;
+        }
+
+        mBinds[i].length = &mLengths[i];
+        mBinds[i].is_null = &mBindNulls[i];
+    }
+
+    mysql_stmt_bind_result(mStmt, &mBinds[0]);
+}
+
+bool QueryResultMysqlBinary::FetchRow(size_t base)
+{
+    int res = mysql_stmt_fetch(mStmt);
+    if (res == MYSQL_NO_DATA)
+        return false;
+
+    if (res == 1)
+    {
+        // for streams this is not the end of the rows, e.g. a net_write_timeout of the server
+        sLog.outErrorDb("query ERROR: %s", mysql_stmt_error(mStmt));
+        mFetchFailed = true;
+        return false;
+    }
+
+    bool rebind = false;
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        mNulls[base + i] = mBindNulls[i] ? 1 : 0;
+        if (mBindNulls[i])
+            continue;
+
+        if (mColumnTypes[i] != Field::BINARY_NONE)
+        {
+            mCells[base + i] = mValues[i];
+            continue;
+        }
+
+        if (mLengths[i] >= mBuffers[i].size())
+        {
+            mBuffers[i].resize(mLengths[i] + 1);
+            mBinds[i].buffer = &mBuffers[i][0];
+            mBinds[i].buffer_length = mBuffers[i].size();
+            mysql_stmt_fetch_column(mStmt, &mBinds[i], i, 0);
+            rebind = true;
+        }
+
+        mCells[base + i].ui64 = mStrings.size();
+        mStrings.insert(mStrings.end(), mBuffers[i].begin(), mBuffers[i].begin() + mLengths[i]);
+        mStrings.push_back('\0');
+    }
+
+    if (rebind)
+        mysql_stmt_bind_result(mStmt, &mBinds[0]);
+
+    return true;
+}
+
+bool QueryResultMysqlBinary::NextRow()
+{
+    if (!mCurrentRow)
+        return false;
+
+    size_t base = 0;
+
+    if (mStreamLock)
+    {
+        // only the current row is kept, its text values replace the ones of the previous row
+        mStrings.clear();
+
+        if (!FetchRow(0))
+        {
+            EndQuery();
+            return false;
+        }
+
+        ++mNextRow;
+    }
+    else
+    {
+        if (mNextRow >= mRowCount)
+        {
+            EndQuery();
+            return false;
+        }
+
+        base = size_t(mNextRow++) * mFieldCount;
+    }
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        if (mNulls[base + i])
+            mCurrentRow[i].SetValue(NULL);
+        else if (mColumnTypes[i] == Field::BINARY_NONE)
+            mCurrentRow[i].SetValue(&mStrings[size_t(mCells[base + i].ui64)]);
+        else
+        {
+            mRowCells[i].value = mCells[base + i];
+            mCurrentRow[i].SetBinaryValue(mColumnTypes[i], &mRowCells[i]);
+        }
+    }
+
+    return true;
+}
+
+void QueryResultMysqlBinary::EndQuery()
+{
+    delete[] mCurrentRow;
+    mCurrentRow = 0;
+
+    CellContainer().swap(mCells);
+    std::vector<uint8>().swap(mNulls);
+    std::vector<char>().swap(mStrings);
+    std::vector<Field::BinaryCell>().swap(mRowCells);
+
+    if (mStreamLock)
+    {
+        // discards not yet fetched rows, the connection can be used again after this
+        mysql_stmt_free_result(mStmt);
+        mysql_free_result(mMetadata);
+        mysql_stmt_close(mStmt);
+        mStmt = NULL;
+        mMetadata = NULL;
+
+        delete mStreamLock;
+        mStreamLock = NULL;
+    }
+}
+
+Field::BinaryTypes QueryResultMysqlBinary::ConvertBinaryType(MYSQL_FIELD const& field)
+{
+    switch (field.type)
+    {
+        case FIELD_TYPE_TINY:
+        case FIELD_TYPE_SHORT:
+        case FIELD_TYPE_LONG:
+        case FIELD_TYPE_INT24:
+        case FIELD_TYPE_LONGLONG:
+            return (field.flags & UNSIGNED_FLAG) ? Field::BINARY_UINT : Field::BINARY_INT;
+        case FIELD_TYPE_FLOAT:
+        case FIELD_TYPE_DOUBLE:
+            return Field::BINARY_FLOAT;
+        default:
+            // decimals, dates and strings keep the same text form as in QueryResultMysql
+            return Field::BINARY_NONE;
+    }
+}
 #endif
@@ -22,6 +22,7 @@
 #define QUERYRESULTMYSQL_H
 
 #include "Common.h"
+#include "Database.h"
 
 #ifdef WIN32
 #include <winsock2.h>
@@ -39,11 +40,66 @@ class QueryResultMysql : public QueryResult
 
         bool NextRow() override;
 
+        static enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType);
+
     private:
-        enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType) const;
         void EndQuery();
 
         MYSQL_RES* mResult;
 };
+
+/// Result of a query executed over the binary protocol (see MySQLConnection::BinaryQuery).
+/// All rows are fetched and decoded once into typed cells, Field getters of numeric
+/// columns then only cast the stored value instead of parsing text at every access.
+///
+/// A streamed result (see MySQLConnection::StreamQuery) decodes the same way, but keeps
+/// only the current row: every NextRow() fetches the next row from the server, the
+/// binary protocol counterpart of mysql_use_result(). Its row count is unknown (0).
+class QueryResultMysqlBinary : public QueryResult
+{
+    public:
+        // fetches all rows of the stored result of the executed statement
+        QueryResultMysqlBinary(MYSQL_STMT* stmt, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount);
+        // streams the rows of the executed statement, takes ownership of statement, metadata and connection lock
+        QueryResultMysqlBinary(MYSQL_STMT* stmt, MYSQL_RES* metadata, uint32 fieldCount, SqlConnection::Lock* streamLock);
+
+        ~QueryResultMysqlBinary();
+
+        bool NextRow() override;
+
+        // not all rows of the stored result could be fetched, or fetching a streamed row failed
+        bool IsIncomplete() const override { return mFetchFailed || mFetchedRows < mStoredRows; }
+        uint64 GetFetchedRowCount() const { return mFetchedRows; }
+        uint64 GetStoredRowCount() const { return mStoredRows; }
+
+    private:
+        static Field::BinaryTypes ConvertBinaryType(MYSQL_FIELD const& field);
+        void BindColumns(MYSQL_FIELD* fields, bool stored);
+        bool FetchRow(size_t base);
+        void EndQuery();
+
+        typedef std::vector<Field::BinaryValue> CellContainer;
+
+        std::vector<Field::BinaryTypes> mColumnTypes;       // BINARY_NONE for columns fetched as text
+        CellContainer mCells;                               // row major, text cells hold an offset into mStrings
+        std::vector<uint8> mNulls;
+        std::vector<char> mStrings;                         // null terminated text values of all rows
+        std::vector<Field::BinaryCell> mRowCells;           // binary values of the current row, referenced by its fields
+        uint64 mNextRow;
+        uint64 mStoredRows;                                 // rows reported by the stored result
+        uint64 mFetchedRows;
+        bool mFetchFailed;                                  // mysql_stmt_fetch() reported an error
+
+        // output binds of one row, numeric columns are converted by the client library
+        std::vector<MYSQL_BIND> mBinds;
+        CellContainer mValues;
+        std::vector<unsigned long> mLengths;
+        std::vector<my_bool> mBindNulls;
+        std::vector<std::vector<char> > mBuffers;
+
+        MYSQL_STMT* mStmt;
+        MYSQL_RES* mMetadata;                               // only set for streamed results
+        SqlConnection::Lock* mStreamLock;                   // connection stays locked until the last row was fetched
+};
 #endif
 #endif
@@ -22,6 +22,7 @@
 #include "ProgressBar.h"
 #include "Log.h"
 #include "DBCFileLoader.h"
+#include "SQLStorageSnapshot.h"
 
 template<class DerivedLoader, class StorageClass>
 template<class S, class D>                                  // S source-type, D destination-type
@@ -168,31 +169,47 @@ template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
     Field* fields = NULL;
-    QueryResult* result  = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
-    if (!result)
-    {
-        sLog.outError("Error loading %s table (not exist?)\n", store.GetTableName());
-        Log::WaitBeforeContinueIfNeed();
-        exit(1);                                            // Stop server at loading non exited table or not accessable table
-    }
-
-    uint32 maxRecordId = (*result)[0].GetUInt32() + 1;
+    QueryResult* result = NULL;
+    uint32 maxRecordId = 0;
     uint32 recordCount = 0;
     uint32 recordsize = 0;
-    delete result;
 
-    result = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", store.GetTableName());
-    if (result)
+    // rows of an unchanged table come from its snapshot
+    SQLStorageSnapshot snapshot(store.GetTableName(), store.GetSrcFormat());
+    if (snapshot.Open())
     {
-        fields = result->Fetch();
-        recordCount = fields[0].GetUInt32();
-        delete result;
+        maxRecordId = snapshot.GetMaxRecordId();
+        recordCount = snapshot.GetRecordCount();
+        result = snapshot.Query();
     }
+    else
+    {
+        result = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
+        if (!result)
+        {
+            sLog.outError("Error loading %s table (not exist?)\n", store.GetTableName());
+            Log::WaitBeforeContinueIfNeed();
+            exit(1);                                        // Stop server at loading non exited table or not accessable table
+        }
+
+        maxRecordId = (*result)[0].GetUInt32() + 1;
+        delete result;
+
+        result = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", store.GetTableName());
+        if (result)
+        {
+            fields = result->Fetch();
+            recordCount = fields[0].GetUInt32();
+            delete result;
+        }
 
-    result = WorldDatabase.PQuery("SELECT * FROM %s", store.GetTableName());
+        result = WorldDatabase.PQuery("SELECT * FROM %s", store.GetTableName());
+    }
 
     if (!result)
     {
+        snapshot.Save(maxRecordId);
+
         if (error_at_empty)
             sLog.outError("%s table is empty!\n", store.GetTableName());
         else
@@ -254,6 +271,8 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         fields = result->Fetch();
         bar.step();
 
+        snapshot.AddRow(fields);
+
         char* record = store.createRecord(fields[0].GetUInt32());
         offset = 0;
 
@@ -304,6 +323,8 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     while (result->NextRow());
 
     delete result;
+
+    snapshot.Save(maxRecordId);
 }
 
 #endif
@@ -0,0 +1,447 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "SQLStorageSnapshot.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+
+#include <ace/Mem_Map.h>
+
+#define SNAPSHOT_MAGIC          0x534C5153                  // 'SQLS'
+#define SNAPSHOT_VERSION        1
+#define SNAPSHOT_NULL_STRING    0xFFFFFFFF                  // length of NULL string columns
+
+std::string SQLStorageSnapshot::m_directory;
+SQLStorageSnapshot::Mode SQLStorageSnapshot::m_mode = SQLStorageSnapshot::SNAPSHOT_USE;
+
+/// Rows of a mapped snapshot served through the usual QueryResult interface
+class QueryResultSnapshot : public QueryResult
+{
+    public:
+        QueryResultSnapshot(uint8 const* rows, uint32 recordCount, char const* srcFormat, uint32 fieldCount) :
+            QueryResult(recordCount, fieldCount), m_nextRow(rows), m_srcFormat(srcFormat), m_fetchedRows(0)
+        {
+            m_fields = new Field[fieldCount];
+            m_cells = new Field::BinaryCell[fieldCount];
+            mCurrentRow = m_fields;
+            NextRow();
+        }
+
+        ~QueryResultSnapshot()
+        {
+            delete[] m_fields;
+            delete[] m_cells;
+        }
+
+        bool NextRow() override
+        {
+            if (m_fetchedRows >= mRowCount)
+                return false;
+
+            // row layout was checked when the snapshot was opened
+            for (uint32 y = 0; y < mFieldCount; ++y)
+            {
+                Field::BinaryValue& value = m_cells[y].value;
+
+                switch (m_srcFormat[y])
+                {
+                    case FT_LOGIC:
+                    case FT_BYTE:
+                    case FT_INT:
+                    {
+                        uint32 intValue;
+                        memcpy(&intValue, m_nextRow, sizeof(uint32));
+                        m_nextRow += sizeof(uint32);
+
+                        value.i64 = intValue;
+                        m_fields[y].SetBinaryValue(Field::BINARY_UINT, &m_cells[y]);
+                        break;
+                    }
+                    case FT_FLOAT:
+                    {
+                        float floatValue;
+                        memcpy(&floatValue, m_nextRow, sizeof(float));
+                        m_nextRow += sizeof(float);
+
+                        value.f = floatValue;
+                        m_fields[y].SetBinaryValue(Field::BINARY_FLOAT, &m_cells[y]);
+                        break;
+                    }
+                    case FT_STRING:
+                    {
+                        uint32 length;
+                        memcpy(&length, m_nextRow, sizeof(uint32));
+                        m_nextRow += sizeof(uint32);
+
+                        if (length == SNAPSHOT_NULL_STRING)
+                            m_fields[y].SetValue(NULL);
+                        else
+                        {
+                            m_fields[y].SetValue((char const*)m_nextRow);
+                            m_nextRow += length + 1;
+                        }
+                        break;
+                    }
+                    default:                                // column not read by the loader
+                        m_fields[y].SetValue(NULL);
+                        break;
+                }
+            }
+
+            ++m_fetchedRows;
+            return true;
+        }
+
+    private:
+        Field* m_fields;
+        Field::BinaryCell* m_cells;                         // binary values of the current row
+        uint8 const* m_nextRow;
+        char const* m_srcFormat;
+        uint64 m_fetchedRows;
+};
+
+void SQLStorageSnapshot::SetDirectory(std::string const& dir)
+{
+    m_directory = dir;
+
+    if (!m_directory.empty() && m_directory[m_directory.size() - 1] != '/' && m_directory[m_directory.size() - 1] != '\\')
+        m_directory.push_back('/');
+}
+
+SQLStorageSnapshot::SQLStorageSnapshot(char const* tableName, char const* srcFormat) :
+    m_tableName(tableName), m_srcFormat(srcFormat), m_srcFieldCount(strlen(srcFormat)),
+    m_enabled(false), m_tableChecksum(0),
+    m_fileMap(NULL), m_rows(NULL), m_rowsSize(0), m_maxRecordId(0), m_recordCount(0),
+    m_newRecordCount(0)
+{
+    m_enabled = IsEnabled() && ReadTableChecksum();
+}
+
+SQLStorageSnapshot::~SQLStorageSnapshot()
+{
+    delete m_fileMap;
+}
+
+std::string SQLStorageSnapshot::GetFileName() const
+{
+    return m_directory + m_tableName + ".snapshot";
+}
+
+bool SQLStorageSnapshot::ReadTableChecksum()
+{
+#ifdef DO_POSTGRESQL
+    return false;                                           // no CHECKSUM TABLE, always load from the database
+#else
+    QueryResult* result = WorldDatabase.PQuery("CHECKSUM TABLE %s", m_tableName);
+    if (!result)
+        return false;
+
+    bool known = !(*result)[1].IsNULL();                    // NULL for not existing tables
+    m_tableChecksum = (*result)[1].GetUInt64();
+    delete result;
+
+    return known;
+#endif
+}
+
+bool SQLStorageSnapshot::GetRowSize(uint8 const* data, size_t size, size_t& rowSize) const
+{
+    rowSize = 0;
+
+    for (uint32 y = 0; y < m_srcFieldCount; ++y)
+    {
+        switch (m_srcFormat[y])
+        {
+            case FT_LOGIC:
+            case FT_BYTE:
+            case FT_INT:
+            case FT_FLOAT:
+                rowSize += sizeof(uint32);
+                break;
+            case FT_STRING:
+            {
+                if (rowSize + sizeof(uint32) > size)
+                    return false;
+
+                uint32 length;
+                memcpy(&length, data + rowSize, sizeof(uint32));
+                rowSize += sizeof(uint32);
+
+                if (length != SNAPSHOT_NULL_STRING)
+                {
+                    if (rowSize + length + 1 > size || data[rowSize + length] != '\0')
+                        return false;
+
+                    rowSize += length + 1;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        if (rowSize > size)
+            return false;
+    }
+
+    return true;
+}
+
+bool SQLStorageSnapshot::MapFile(ACE_Mem_Map*& fileMap, uint64& tableChecksum, uint32& maxRecordId, uint32& recordCount, uint8 const*& rows, size_t& rowsSize) const
+{
+    std::string fileName = GetFileName();
+
+    fileMap = new ACE_Mem_Map();
+    if (fileMap->map(fileName.c_str(), static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) != 0)
+    {
+        delete fileMap;
+        fileMap = NULL;
+        return false;
+    }
+
+    fileMap->close_handle();
+
+    uint8 const* data = (uint8 const*)fileMap->addr();
+    size_t size = fileMap->size();
+
+    // magic, version, table checksum, max record id, record count, format length, format, rows size
+    uint32 magic = 0, version = 0, formatLength = 0;
+    uint64 rowsSize64 = 0;
+    size_t headerSize = 4 * sizeof(uint32) + sizeof(uint64) + sizeof(uint32) + m_srcFieldCount + sizeof(uint64);
+
+    bool valid = size >= headerSize;
+    if (valid)
+    {
+        memcpy(&magic, data, sizeof(uint32));
+        data += sizeof(uint32);
+        memcpy(&version, data, sizeof(uint32));
+        data += sizeof(uint32);
+        memcpy(&tableChecksum, data, sizeof(uint64));
+        data += sizeof(uint64);
+        memcpy(&maxRecordId, data, sizeof(uint32));
+        data += sizeof(uint32);
+        memcpy(&recordCount, data, sizeof(uint32));
+        data += sizeof(uint32);
+        memcpy(&formatLength, data, sizeof(uint32));
+        data += sizeof(uint32);
+
+        // written by another server version or for a changed table structure
+        valid = magic == SNAPSHOT_MAGIC && version == SNAPSHOT_VERSION &&
+                formatLength == m_srcFieldCount && memcmp(data, m_srcFormat, m_srcFieldCount) == 0;
+        data += m_srcFieldCount;
+    }
+
+    if (valid)
+    {
+        memcpy(&rowsSize64, data, sizeof(uint64));
+        data += sizeof(uint64);
+        valid = rowsSize64 == size - headerSize;
+    }
+
+    // a truncated or damaged file must not be trusted, walk all rows once
+    if (valid)
+    {
+        rows = data;
+        rowsSize = size_t(rowsSize64);
+
+        size_t offset = 0;
+        for (uint32 i = 0; valid && i < recordCount; ++i)
+        {
+            size_t rowSize = 0;
+            valid = GetRowSize(rows + offset, rowsSize - offset, rowSize);
+            offset += rowSize;
+        }
+
+        valid = valid && offset == rowsSize;
+    }
+
+    if (!valid)
+    {
+        sLog.outError("Snapshot %s is damaged or outdated, it will be rebuilt", fileName.c_str());
+        delete fileMap;
+        fileMap = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+bool SQLStorageSnapshot::Open()
+{
+    if (!m_enabled || m_mode != SNAPSHOT_USE)
+        return false;
+
+    uint64 tableChecksum = 0;
+    if (!MapFile(m_fileMap, tableChecksum, m_maxRecordId, m_recordCount, m_rows, m_rowsSize))
+        return false;
+
+    if (tableChecksum != m_tableChecksum)                   // table changed since the snapshot was written
+    {
+        delete m_fileMap;
+        m_fileMap = NULL;
+        return false;
+    }
+
+    sLog.outString("Loading %s from snapshot", m_tableName);
+    return true;
+}
+
+QueryResult* SQLStorageSnapshot::Query()
+{
+    if (!m_fileMap || !m_recordCount)
+        return NULL;
+
+    return new QueryResultSnapshot(m_rows, m_recordCount, m_srcFormat, m_srcFieldCount);
+}
+
+void SQLStorageSnapshot::AddRow(Field const* fields)
+{
+    if (!m_enabled || m_fileMap)
+        return;
+
+    for (uint32 y = 0; y < m_srcFieldCount; ++y)
+    {
+        switch (m_srcFormat[y])
+        {
+            case FT_LOGIC:
+            case FT_BYTE:
+            case FT_INT:
+                AppendValue(fields[y].GetUInt32());
+                break;
+            case FT_FLOAT:
+                AppendValue(fields[y].GetFloat());
+                break;
+            case FT_STRING:
+            {
+                char const* value = fields[y].GetString();
+                if (!value)
+                {
+                    AppendValue(uint32(SNAPSHOT_NULL_STRING));
+                    break;
+                }
+
+                uint32 length = strlen(value);
+                AppendValue(length);
+                m_newRows.insert(m_newRows.end(), (uint8 const*)value, (uint8 const*)value + length + 1);
+                break;
+            }
+            default:                                        // column not read by the loader
+                break;
+        }
+    }
+
+    ++m_newRecordCount;
+}
+
+void SQLStorageSnapshot::Save(uint32 maxRecordId)
+{
+    if (!m_enabled || m_fileMap)
+        return;
+
+    if (m_mode == SNAPSHOT_VERIFY)
+        CompareWithFile(maxRecordId);
+
+    WriteFile(maxRecordId);
+}
+
+void SQLStorageSnapshot::CompareWithFile(uint32 maxRecordId) const
+{
+    ACE_Mem_Map* fileMap = NULL;
+    uint64 tableChecksum = 0;
+    uint32 fileMaxRecordId = 0, fileRecordCount = 0;
+    uint8 const* rows = NULL;
+    size_t rowsSize = 0;
+
+    if (!MapFile(fileMap, tableChecksum, fileMaxRecordId, fileRecordCount, rows, rowsSize))
+    {
+        sLog.outString("Snapshot of %s: no usable snapshot to compare with", m_tableName);
+        return;
+    }
+
+    // compare row by row to be able to name the first differing entry
+    uint8 const* newRows = m_newRows.empty() ? NULL : &m_newRows[0];
+    size_t offset = 0, newOffset = 0;
+    uint32 differentRows = 0;
+    uint32 firstDifferentEntry = 0;
+
+    for (uint32 i = 0; i < fileRecordCount && i < m_newRecordCount; ++i)
+    {
+        size_t rowSize = 0, newRowSize = 0;
+        GetRowSize(rows + offset, rowsSize - offset, rowSize);
+        GetRowSize(newRows + newOffset, m_newRows.size() - newOffset, newRowSize);
+
+        if (rowSize != newRowSize || memcmp(rows + offset, newRows + newOffset, rowSize) != 0)
+        {
+            if (!differentRows && newRowSize >= sizeof(uint32) && m_srcFormat[0] == FT_INT)
+                memcpy(&firstDifferentEntry, newRows + newOffset, sizeof(uint32));
+
+            ++differentRows;
+        }
+
+        offset += rowSize;
+        newOffset += newRowSize;
+    }
+
+    if (!differentRows && fileRecordCount == m_newRecordCount && fileMaxRecordId == maxRecordId)
+        sLog.outString("Snapshot of %s matches the database (%u rows%s)", m_tableName, m_newRecordCount,
+                       tableChecksum != m_tableChecksum ? ", table checksum changed" : "");
+    else
+        sLog.outError("Snapshot of %s differs from the database: %u rows in snapshot, %u in database, %u compared rows differ (first at entry %u)",
+                      m_tableName, fileRecordCount, m_newRecordCount, differentRows, firstDifferentEntry);
+
+    delete fileMap;
+}
+
+void SQLStorageSnapshot::WriteFile(uint32 maxRecordId) const
+{
+    std::string fileName = GetFileName();
+    std::string tmpFileName = fileName + ".tmp";
+
+    FILE* f = fopen(tmpFileName.c_str(), "wb");
+    if (!f)
+    {
+        sLog.outError("Can't create snapshot %s, check that the snapshot directory exists", tmpFileName.c_str());
+        return;
+    }
+
+    uint32 magic = SNAPSHOT_MAGIC;
+    uint32 version = SNAPSHOT_VERSION;
+    uint32 formatLength = m_srcFieldCount;
+    uint64 rowsSize = m_newRows.size();
+
+    bool written =
+        fwrite(&magic, sizeof(uint32), 1, f) == 1 &&
+        fwrite(&version, sizeof(uint32), 1, f) == 1 &&
+        fwrite(&m_tableChecksum, sizeof(uint64), 1, f) == 1 &&
+        fwrite(&maxRecordId, sizeof(uint32), 1, f) == 1 &&
+        fwrite(&m_newRecordCount, sizeof(uint32), 1, f) == 1 &&
+        fwrite(&formatLength, sizeof(uint32), 1, f) == 1 &&
+        fwrite(m_srcFormat, 1, formatLength, f) == formatLength &&
+        fwrite(&rowsSize, sizeof(uint64), 1, f) == 1 &&
+        (m_newRows.empty() || fwrite(&m_newRows[0], m_newRows.size(), 1, f) == 1);
+
+    written = fclose(f) == 0 && written;
+
+    // replace the old snapshot only by a complete file
+    if (!written || (remove(fileName.c_str()) != 0 && errno != ENOENT) || rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+    {
+        sLog.outError("Can't write snapshot %s", fileName.c_str());
+        remove(tmpFileName.c_str());
+    }
+}
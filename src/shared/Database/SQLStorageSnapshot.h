@@ -0,0 +1,104 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef SQLSTORAGE_SNAPSHOT_H
+#define SQLSTORAGE_SNAPSHOT_H
+
+#include "Common.h"
+
+#include <vector>
+
+class Field;
+class QueryResult;
+class ACE_Mem_Map;
+
+/**
+ * On-disk copy of the rows a SQLStorage loader reads from the world database.
+ *
+ * The snapshot keeps the source columns of every row (not the converted records), so
+ * loader specific conversions like script name lookups still run at each boot. It is
+ * keyed by CHECKSUM TABLE of the source table and by the source format, and rebuilt as
+ * soon as one of them changed. Snapshots are only used when a directory is configured.
+ */
+class SQLStorageSnapshot
+{
+    public:
+        enum Mode
+        {
+            SNAPSHOT_USE        = 0,                        // load valid snapshots, rebuild the others
+            SNAPSHOT_REBUILD    = 1,                        // ignore existing snapshots, write new ones
+            SNAPSHOT_VERIFY     = 2,                        // load from the database and compare with the snapshots
+        };
+
+        static void SetDirectory(std::string const& dir);
+        static void SetMode(Mode mode) { m_mode = mode; }
+        static bool IsEnabled() { return !m_directory.empty(); }
+
+        SQLStorageSnapshot(char const* tableName, char const* srcFormat);
+        ~SQLStorageSnapshot();
+
+        // map the snapshot if it still matches the table, false means rows have to come from the database
+        bool Open();
+        uint32 GetMaxRecordId() const { return m_maxRecordId; }
+        uint32 GetRecordCount() const { return m_recordCount; }
+        // rows of an opened snapshot, positioned at the first row like a database result, NULL if empty
+        QueryResult* Query();
+
+        // collect a row read from the database for the new snapshot
+        void AddRow(Field const* fields);
+        // verify and/or write the collected rows
+        void Save(uint32 maxRecordId);
+
+    private:
+        std::string GetFileName() const;
+        bool ReadTableChecksum();
+        // map the snapshot file and check that it is complete and uses the current format
+        bool MapFile(ACE_Mem_Map*& fileMap, uint64& tableChecksum, uint32& maxRecordId, uint32& recordCount, uint8 const*& rows, size_t& rowsSize) const;
+        // size of the row at data, false if it does not fit into the remaining size
+        bool GetRowSize(uint8 const* data, size_t size, size_t& rowSize) const;
+        // log the differences between the snapshot file and the rows read from the database
+        void CompareWithFile(uint32 maxRecordId) const;
+        void WriteFile(uint32 maxRecordId) const;
+
+        template<class T>
+        void AppendValue(T value) { m_newRows.insert(m_newRows.end(), (uint8 const*)&value, (uint8 const*)&value + sizeof(T)); }
+
+        static std::string m_directory;
+        static Mode m_mode;
+
+        char const* m_tableName;
+        char const* m_srcFormat;
+        uint32 m_srcFieldCount;
+
+        bool m_enabled;                                     // snapshot dir set and table checksum known
+        uint64 m_tableChecksum;
+
+        // opened snapshot
+        ACE_Mem_Map* m_fileMap;
+        uint8 const* m_rows;
+        size_t m_rowsSize;
+        uint32 m_maxRecordId;
+        uint32 m_recordCount;
+
+        // rows read from the database
+        std::vector<uint8> m_newRows;
+        uint32 m_newRecordCount;
+};
+
+#endif
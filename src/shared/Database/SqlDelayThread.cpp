@@ -20,14 +20,136 @@
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+#include <sstream>
+
+void SqlDelayStats::Reset()
+{
+    operations = 0;
+    barriers = 0;
+
+    for (int i = 0; i < SQL_DELAY_HISTOGRAM_SIZE; ++i)
+    {
+        queueDepth[i] = 0;
+        latency[i] = 0;
+    }
+}
+
+void SqlDelayStats::Add(SqlDelayStats const& other)
+{
+    operations += other.operations;
+    barriers += other.barriers;
+
+    for (int i = 0; i < SQL_DELAY_HISTOGRAM_SIZE; ++i)
+    {
+        queueDepth[i] += other.queueDepth[i];
+        latency[i] += other.latency[i];
+    }
+}
+
+uint32 SqlDelayStats::GetBucket(uint64 value)
+{
+    uint32 bucket = 0;
+
+    while (value && bucket < SQL_DELAY_HISTOGRAM_SIZE - 1)
+    {
+        value >>= 1;
+        ++bucket;
+    }
+
+    return bucket;
+}
+
+std::string SqlDelayStats::FormatHistogram(uint64 const* histogram)
+{
+    std::ostringstream ss;
+
+    for (uint32 i = 0; i < SQL_DELAY_HISTOGRAM_SIZE; ++i)
+    {
+        if (!histogram[i])
+            continue;
+
+        if (i <= 1)
+            ss << " " << i;
+        else if (i == SQL_DELAY_HISTOGRAM_SIZE - 1)
+            ss << " " << (1 << (i - 1)) << "+";
+        else
+            ss << " " << (1 << (i - 1)) << "-" << ((1 << i) - 1);
+
+        ss << ":" << histogram[i];
+    }
+
+    return ss.str();
+}
+
+void SqlOperationStats::Add(SqlOperationStats const& other)
+{
+    count += other.count;
+    rows += other.rows;
+    execTime += other.execTime;
+    maxExecTime = std::max(maxExecTime, other.maxExecTime);
+    waitTime += other.waitTime;
+
+    for (int i = 0; i < SQL_DELAY_HISTOGRAM_SIZE; ++i)
+        latency[i] += other.latency[i];
+}
+
+void SqlOperationStats::Record(uint64 execUs, uint64 waitUs, uint64 rowCount)
+{
+    ++count;
+    rows += rowCount;
+    execTime += execUs;
+    maxExecTime = std::max(maxExecTime, execUs);
+    waitTime += waitUs;
+
+    ++latency[SqlDelayStats::GetBucket(execUs / 1000)];
+}
+
+SqlDelayBarrier::SqlDelayBarrier(SqlOperation* sql, uint32 workers) :
+    m_sql(sql), m_workers(workers), m_arrived(0), m_left(0), m_executed(false),
+    m_executedCondition(m_lock)
+{
+}
+
+SqlDelayBarrier::~SqlDelayBarrier()
+{
+    delete m_sql;
+}
+
+bool SqlDelayBarrier::Pass(SqlDelayThread* worker, ACE_Time_Value const& queueTime)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    if (++m_arrived == m_workers)
+    {
+        // all older requests of every worker are done, and none of the newer ones started
+        worker->ExecuteOperation(m_sql, queueTime);
+        m_executed = true;
+        m_executedCondition.broadcast();
+    }
+    else
+    {
+        while (!m_executed)
+            m_executedCondition.wait();
+    }
+
+    return ++m_left == m_workers;
+}
+
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase) :
+    m_dbEngine(db), m_dbConnection(conn), m_pingDatabase(pingDatabase), m_running(true),
+    m_queueCondition(m_queueLock)
 {
 }
 
 SqlDelayThread::~SqlDelayThread()
 {
-    // process all requests which might have been queued while thread was stopping
-    ProcessRequests();
+    // run() only returns with an empty queue, this is for a worker thread that never started
+    while (!m_sqlQueue.empty())
+    {
+        QueuedRequest request = m_sqlQueue.front();
+        m_sqlQueue.pop_front();
+        ProcessRequest(request);
+    }
 }
 
 void SqlDelayThread::run()
@@ -36,23 +158,47 @@ void SqlDelayThread::run()
     mysql_thread_init();
 #endif
 
-    const uint32 loopSleepms = 10;
+    ACE_Time_Value pingInterval;
+    pingInterval.msec(long(m_dbEngine->GetPingIntervall()));
 
-    const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
+    bool pingDatabase = m_pingDatabase && pingInterval != ACE_Time_Value::zero;
+    ACE_Time_Value nextPing = ACE_OS::gettimeofday() + pingInterval;
 
-    uint32 loopCounter = 0;
-    while (m_running)
+    for (;;)
     {
-        // if the running state gets turned off while sleeping
-        // empty the queue before exiting
-        ACE_Based::Thread::Sleep(loopSleepms);
+        bool haveRequest = false;
+        QueuedRequest request(NULL, NULL, ACE_Time_Value::zero);
+
+        {
+            ACE_Guard<ACE_Thread_Mutex> guard(m_queueLock);
+
+            // sleep until there is work, the worker is stopped or the next ping is due
+            while (m_sqlQueue.empty() && m_running)
+            {
+                if (!pingDatabase)
+                    m_queueCondition.wait();
+                else if (m_queueCondition.wait(&nextPing) == -1)
+                    break;
+            }
+
+            if (!m_sqlQueue.empty())
+            {
+                request = m_sqlQueue.front();
+                m_sqlQueue.pop_front();
+                haveRequest = true;
+            }
+            // stopped workers leave only with an empty queue
+            else if (!m_running)
+                break;
+        }
 
-        ProcessRequests();
+        if (haveRequest)
+            ProcessRequest(request);
 
-        if ((loopCounter++) >= pingEveryLoop)
+        if (pingDatabase && ACE_OS::gettimeofday() >= nextPing)
         {
-            loopCounter = 0;
             m_dbEngine->Ping();
+            nextPing = ACE_OS::gettimeofday() + pingInterval;
         }
     }
 
@@ -63,15 +209,85 @@ void SqlDelayThread::run()
 
 void SqlDelayThread::Stop()
 {
+    ACE_Guard<ACE_Thread_Mutex> guard(m_queueLock);
+
     m_running = false;
+    m_queueCondition.broadcast();
+}
+
+bool SqlDelayThread::Delay(SqlOperation* sql, SqlDelayBarrier* barrier)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_queueLock);
+
+    if (!m_running)
+        return false;
+
+    ++m_stats.queueDepth[SqlDelayStats::GetBucket(m_sqlQueue.size())];
+
+    m_sqlQueue.push_back(QueuedRequest(sql, barrier, ACE_OS::gettimeofday()));
+    m_queueCondition.signal();
+    return true;
 }
 
-void SqlDelayThread::ProcessRequests()
+void SqlDelayThread::ProcessRequest(QueuedRequest const& request)
 {
-    SqlOperation* s = NULL;
-    while (m_sqlQueue.next(s))
+    if (request.m_barrier)
     {
-        s->Execute(m_dbConnection);
-        delete s;
+        if (request.m_barrier->Pass(this, request.m_queueTime))
+            delete request.m_barrier;
     }
+    else
+    {
+        ExecuteOperation(request.m_sql, request.m_queueTime);
+        delete request.m_sql;
+    }
+
+    ACE_Time_Value spentTime = ACE_OS::gettimeofday() - request.m_queueTime;
+
+    ACE_Guard<ACE_Thread_Mutex> guard(m_queueLock);
+
+    if (request.m_barrier)
+        ++m_stats.barriers;
+    else
+        ++m_stats.operations;
+
+    ++m_stats.latency[SqlDelayStats::GetBucket(spentTime.msec())];
+}
+
+void SqlDelayThread::ExecuteOperation(SqlOperation* sql, ACE_Time_Value const& queueTime)
+{
+    // the key must be taken before execution, holders may be deleted by their callback right after it
+    std::string key;
+    sql->GetProfileKey(*m_dbEngine, key);
+
+    ACE_Time_Value startTime = ACE_OS::gettimeofday();
+    sql->Execute(m_dbConnection);
+    ACE_Time_Value endTime = ACE_OS::gettimeofday();
+
+    ACE_UINT64 execTime, waitTime;
+    (endTime - startTime).to_usec(execTime);
+    (startTime - queueTime).to_usec(waitTime);
+
+    ACE_Guard<ACE_Thread_Mutex> guard(m_queueLock);
+    m_profile[key].Record(execTime, waitTime, sql->GetProfileRows());
+}
+
+void SqlDelayThread::GetStats(SqlDelayStats& stats)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_queueLock);
+    stats.Add(m_stats);
+}
+
+void SqlDelayThread::GetProfile(SqlOperationProfile& profile)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_queueLock);
+
+    for (SqlOperationProfile::const_iterator itr = m_profile.begin(); itr != m_profile.end(); ++itr)
+        profile[itr->first].Add(itr->second);
+}
+
+void SqlDelayThread::ResetProfile()
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_queueLock);
+    m_profile.clear();
 }
@@ -19,35 +19,139 @@
 #ifndef __SQLDELAYTHREAD_H
 #define __SQLDELAYTHREAD_H
 
+#include "Common.h"
 #include "ace/Thread_Mutex.h"
-#include "LockedQueue.h"
+#include "ace/Condition_Thread_Mutex.h"
+#include "ace/Time_Value.h"
 #include "Threading.h"
 
+#include <deque>
+#include <map>
+
 class Database;
 class SqlOperation;
 class SqlConnection;
+class SqlDelayThread;
 
-class SqlDelayThread : public ACE_Based::Runnable
+#define SQL_DELAY_HISTOGRAM_SIZE 16
+
+/// Histograms of one or more async workers, bucket 0 counts 0, bucket i counts values in [2^(i-1), 2^i),
+/// the last bucket everything above.
+struct SqlDelayStats
+{
+    SqlDelayStats() { Reset(); }
+
+    void Reset();
+    void Add(SqlDelayStats const& other);
+
+    static uint32 GetBucket(uint64 value);
+    // non empty buckets of a histogram as "range:count" pairs
+    static std::string FormatHistogram(uint64 const* histogram);
+
+    uint64 operations;                                      ///< Executed operations, barriers excluded
+    uint64 barriers;                                        ///< Barriers passed, counted once per worker
+    uint64 queueDepth[SQL_DELAY_HISTOGRAM_SIZE];            ///< Queued operations seen by a new operation
+    uint64 latency[SQL_DELAY_HISTOGRAM_SIZE];               ///< Milliseconds from queueing to end of execution
+};
+
+/// Execution profile of all async operations sharing one statement template.
+struct SqlOperationStats
 {
-        typedef ACE_Based::LockedQueue<SqlOperation*, ACE_Thread_Mutex> SqlQueue;
+    SqlOperationStats() : count(0), rows(0), execTime(0), maxExecTime(0), waitTime(0)
+    {
+        for (int i = 0; i < SQL_DELAY_HISTOGRAM_SIZE; ++i)
+            latency[i] = 0;
+    }
+
+    void Add(SqlOperationStats const& other);
+    void Record(uint64 execUs, uint64 waitUs, uint64 rowCount);
+
+    uint64 count;
+    uint64 rows;                                            ///< Rows returned by queries
+    uint64 execTime;                                        ///< Microseconds spent executing
+    uint64 maxExecTime;                                     ///< Slowest single execution, microseconds
+    uint64 waitTime;                                        ///< Microseconds spent in the queue before execution
+    uint64 latency[SQL_DELAY_HISTOGRAM_SIZE];               ///< Execution milliseconds
+};
+
+/// Statement template (literals replaced by '?', see SqlOperation::GetProfileKey) -> profile
+typedef std::map<std::string, SqlOperationStats> SqlOperationProfile;
+typedef std::vector<std::pair<std::string, SqlOperationStats> > SqlOperationProfileList;
+
+/// Operation without shard key, queued to every worker and executed once all of them reached it,
+/// so it stays ordered against everything queued before and after it.
+class SqlDelayBarrier
+{
+    public:
+        SqlDelayBarrier(SqlOperation* sql, uint32 workers);
+        ~SqlDelayBarrier();
+
+        /// Called by every worker, the last one to arrive executes the operation on its connection
+        /// while the others wait. Returns true for the last worker to leave, which has to delete the barrier.
+        bool Pass(SqlDelayThread* worker, ACE_Time_Value const& queueTime);
 
     private:
-        SqlQueue m_sqlQueue;                                ///< Queue of SQL statements
-        Database* m_dbEngine;                               ///< Pointer to used Database engine
-        SqlConnection* m_dbConnection;                      ///< Pointer to DB connection
-        volatile bool m_running;
+        SqlOperation* m_sql;
+        uint32 m_workers;
+        uint32 m_arrived;
+        uint32 m_left;
+        bool m_executed;
 
-        // process all enqueued requests
-        void ProcessRequests();
+        ACE_Thread_Mutex m_lock;
+        ACE_Condition_Thread_Mutex m_executedCondition;
+};
 
+/// One worker of the async executor of a Database, owns one connection and executes its queue in order.
+class SqlDelayThread : public ACE_Based::Runnable
+{
     public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase);
         ~SqlDelayThread();
 
-        ///< Put sql statement to delay queue
-        bool Delay(SqlOperation* sql) { m_sqlQueue.add(sql); return true; }
+        ///< Put sql statement to delay queue, false if the worker is already stopped
+        bool Delay(SqlOperation* sql) { return Delay(sql, NULL); }
+        bool Delay(SqlDelayBarrier* barrier) { return Delay(NULL, barrier); }
 
-        virtual void Stop();                                ///< Stop event
+        virtual void Stop();                                ///< Stop event, queued requests are still processed
         virtual void run();                                 ///< Main Thread loop
+
+        /// Add the histograms of this worker to stats
+        void GetStats(SqlDelayStats& stats);
+        /// Add the per template profile of this worker to profile
+        void GetProfile(SqlOperationProfile& profile);
+        void ResetProfile();
+
+        /// Execute the operation on the connection of this worker and record it in the profile
+        void ExecuteOperation(SqlOperation* sql, ACE_Time_Value const& queueTime);
+
+    private:
+        struct QueuedRequest
+        {
+            QueuedRequest(SqlOperation* sql, SqlDelayBarrier* barrier, ACE_Time_Value const& queueTime)
+                : m_sql(sql), m_barrier(barrier), m_queueTime(queueTime) {}
+
+            SqlOperation* m_sql;
+            SqlDelayBarrier* m_barrier;
+            ACE_Time_Value m_queueTime;
+        };
+
+        typedef std::deque<QueuedRequest> SqlQueue;
+
+        bool Delay(SqlOperation* sql, SqlDelayBarrier* barrier);
+
+        // execute one dequeued request
+        void ProcessRequest(QueuedRequest const& request);
+
+        SqlQueue m_sqlQueue;                                ///< Queue of SQL statements
+        Database* m_dbEngine;                               ///< Pointer to used Database engine
+        SqlConnection* m_dbConnection;                      ///< Pointer to DB connection
+        bool m_pingDatabase;                                ///< This worker pings all connections of the database
+        bool m_running;
+
+        ACE_Thread_Mutex m_queueLock;                       ///< Protects queue, running state, stats and profile
+        ACE_Condition_Thread_Mutex m_queueCondition;        ///< Signaled on new requests and at stop
+
+        SqlDelayStats m_stats;
+        SqlOperationProfile m_profile;
 };
 #endif                                                      //__SQLDELAYTHREAD_H
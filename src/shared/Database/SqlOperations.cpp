@@ -17,12 +17,57 @@
  */
 
 #include "SqlOperations.h"
-#include "SqlDelayThread.h"
 #include "DatabaseEnv.h"
 #include "DatabaseImpl.h"
 
 #define LOCK_DB_CONN(conn) SqlConnection::Lock guard(conn)
 
+void SqlOperation::MakeProfileKey(char const* sql, std::string& key)
+{
+    // identifiers may contain digits, only free standing numbers are literals
+    bool inWord = false;
+
+    for (; *sql && key.size() < SQL_PROFILE_KEY_LENGTH; ++sql)
+    {
+        char c = *sql;
+
+        if (c == '\'' || c == '"')
+        {
+            // skip the quoted string, backslash escapes included
+            for (++sql; *sql && *sql != c; ++sql)
+                if (*sql == '\\' && *(sql + 1))
+                    ++sql;
+
+            key += '?';
+            inWord = false;
+            if (!*sql)
+                break;
+        }
+        else if (isdigit((unsigned char)c) && !inWord)
+        {
+            while (isalnum((unsigned char)*(sql + 1)) || *(sql + 1) == '.')
+                ++sql;
+
+            key += '?';
+        }
+        else if (isspace((unsigned char)c))
+        {
+            if (!key.empty() && key[key.size() - 1] != ' ')
+                key += ' ';
+            inWord = false;
+        }
+        else
+        {
+            key += c;
+            inWord = isalnum((unsigned char)c) || c == '_' || c == '`';
+        }
+    }
+
+    // multi row inserts differ only in the cut off part
+    if (*sql)
+        key += "...";
+}
+
 /// ---- ASYNC STATEMENTS / TRANSACTIONS ----
 
 bool SqlPlainRequest::Execute(SqlConnection* conn)
@@ -65,6 +110,14 @@ bool SqlTransaction::Execute(SqlConnection* conn)
     return conn->CommitTransaction();
 }
 
+void SqlTransaction::GetProfileKey(Database const& db, std::string& key) const
+{
+    // the first statement tells which save this is
+    key = "TRANSACTION: ";
+    if (!m_queue.empty())
+        m_queue.front()->GetProfileKey(db, key);
+}
+
 SqlPreparedRequest::SqlPreparedRequest(int nIndex, SqlStmtParameters* arg) : m_nIndex(nIndex), m_param(arg)
 {
 }
@@ -80,8 +133,22 @@ bool SqlPreparedRequest::Execute(SqlConnection* conn)
     return conn->ExecuteStmt(m_nIndex, *m_param);
 }
 
+void SqlPreparedRequest::GetProfileKey(Database const& db, std::string& key) const
+{
+    MakeProfileKey(db.GetStmtString(m_nIndex).c_str(), key);
+}
+
 /// ---- ASYNC QUERIES ----
 
+SqlQuery::~SqlQuery()
+{
+    char* tofree = const_cast<char*>(m_sql);
+    delete[] tofree;
+
+    if (m_queue)
+        m_queue->RemoveReference();
+}
+
 bool SqlQuery::Execute(SqlConnection* conn)
 {
     if (!m_callback || !m_queue)
@@ -89,9 +156,11 @@ bool SqlQuery::Execute(SqlConnection* conn)
 
     LOCK_DB_CONN(conn);
     /// execute the query and store the result in the callback
-    m_callback->SetResult(conn->Query(m_sql));
-    /// add the callback to the sql result queue of the thread it originated from
-    m_queue->add(m_callback);
+    QueryResult* result = conn->Query(m_sql);
+    m_rows = result ? result->GetRowCount() : 0;
+    m_callback->SetResult(result);
+    /// add the callback to the sql result queue of the thread that owns the requester
+    m_queue->Deliver(m_callback);
 
     return true;
 }
@@ -107,16 +176,47 @@ void SqlResultQueue::Update()
     }
 }
 
-bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue)
+void SqlResultQueue::Deliver(MaNGOS::IQueryCallback* callback)
 {
-    if (!callback || !thread || !queue)
+    ACE_Guard<ACE_Thread_Mutex> guard(m_closeLock);
+
+    if (m_closed)
+        DropCallback(callback);
+    else
+        add(callback);
+}
+
+void SqlResultQueue::Close()
+{
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_closeLock);
+        m_closed = true;
+
+        MaNGOS::IQueryCallback* callback = NULL;
+        while (next(callback))
+            DropCallback(callback);
+    }
+
+    RemoveReference();
+}
+
+void SqlResultQueue::DropCallback(MaNGOS::IQueryCallback* callback)
+{
+    // the callback is never executed, so the result and whatever else its handler owns are freed here
+    delete callback->GetResult();
+    callback->Drop();
+    delete callback;
+}
+
+bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, Database* db, SqlResultQueue* queue)
+{
+    if (!callback || !db || !queue)
         return false;
 
     /// delay the execution of the queries, sync them with the delay thread
     /// which will in turn resync on execution (via the queue) and call back
     SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue);
-    thread->Delay(holderEx);
-    return true;
+    return db->Delay(holderEx, m_shardKey);
 }
 
 bool SqlQueryHolder::SetQuery(size_t index, const char* sql)
@@ -206,6 +306,22 @@ void SqlQueryHolder::SetSize(size_t size)
     m_queries.resize(size);
 }
 
+void SqlQueryHolderEx::GetProfileKey(Database const& /*db*/, std::string& key) const
+{
+    // holders are told apart by their first query
+    key = "HOLDER: ";
+
+    std::vector<SqlQueryHolder::SqlResultPair> const& queries = m_holder->m_queries;
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        if (queries[i].first)
+        {
+            MakeProfileKey(queries[i].first, key);
+            break;
+        }
+    }
+}
+
 bool SqlQueryHolderEx::Execute(SqlConnection* conn)
 {
     if (!m_holder || !m_callback || !m_queue)
@@ -218,11 +334,17 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
     {
         /// execute all queries in the holder and pass the results
         char const* sql = queries[i].first;
-        if (sql) m_holder->SetResult(i, conn->Query(sql));
+        if (!sql)
+            continue;
+
+        QueryResult* result = conn->Query(sql);
+        if (result)
+            m_rows += result->GetRowCount();
+        m_holder->SetResult(i, result);
     }
 
     /// sync with the caller thread
-    m_queue->add(m_callback);
+    m_queue->Deliver(m_callback);
 
     return true;
 }
@@ -22,15 +22,17 @@
 #include "Common.h"
 
 #include "ace/Thread_Mutex.h"
+#include "ace/Atomic_Op.h"
 #include "LockedQueue.h"
 #include <queue>
 #include "Utilities/Callback.h"
 
 /// ---- BASE ---
 
+#define SQL_PROFILE_KEY_LENGTH 100
+
 class Database;
 class SqlConnection;
-class SqlDelayThread;
 class SqlStmtParameters;
 
 class SqlOperation
@@ -39,6 +41,14 @@ class SqlOperation
         virtual void OnRemove() { delete this; }
         virtual bool Execute(SqlConnection* conn) = 0;
         virtual ~SqlOperation() {}
+
+        // statement template the operation is profiled under by the async workers
+        virtual void GetProfileKey(Database const& db, std::string& key) const = 0;
+        // rows returned by the last Execute()
+        virtual uint64 GetProfileRows() const { return 0; }
+
+        // sql with literals replaced by '?' and cut after SQL_PROFILE_KEY_LENGTH characters
+        static void MakeProfileKey(char const* sql, std::string& key);
 };
 
 /// ---- ASYNC STATEMENTS / TRANSACTIONS ----
@@ -51,6 +61,7 @@ class SqlPlainRequest : public SqlOperation
         SqlPlainRequest(const char* sql) : m_sql(mangos_strdup(sql)) {}
         ~SqlPlainRequest() { char* tofree = const_cast<char*>(m_sql); delete[] tofree; }
         bool Execute(SqlConnection* conn) override;
+        void GetProfileKey(Database const& /*db*/, std::string& key) const override { MakeProfileKey(m_sql, key); }
 };
 
 class SqlTransaction : public SqlOperation
@@ -65,6 +76,7 @@ class SqlTransaction : public SqlOperation
         void DelayExecute(SqlOperation* sql) { m_queue.push_back(sql); }
 
         bool Execute(SqlConnection* conn) override;
+        void GetProfileKey(Database const& db, std::string& key) const override;
 };
 
 class SqlPreparedRequest : public SqlOperation
@@ -74,6 +86,7 @@ class SqlPreparedRequest : public SqlOperation
         ~SqlPreparedRequest();
 
         bool Execute(SqlConnection* conn) override;
+        void GetProfileKey(Database const& db, std::string& key) const override;
 
     private:
         const int m_nIndex;
@@ -88,11 +101,40 @@ class SqlResultQueue;                                       /// queue for thread
 class SqlQueryHolder;                                       /// groups several async quries
 class SqlQueryHolderEx;                                     /// points to a holder, added to the delay thread
 
+/**
+ * Callbacks of finished async queries, executed by the thread that owns the queue in Update().
+ *
+ * Every Database has one queue drained by the world thread, maps and sessions own their own
+ * queue so that callbacks run in the thread updating them. The queue is shared by its owner and
+ * the queries still delivering into it: the owner calls Close() instead of deleting it, later
+ * results are dropped and the last reference deletes the queue.
+ */
 class SqlResultQueue : public ACE_Based::LockedQueue<MaNGOS::IQueryCallback* , ACE_Thread_Mutex>
 {
     public:
-        SqlResultQueue() {}
+        SqlResultQueue() : m_refs(1), m_closed(false) {}
         void Update();
+
+        void AddReference() { ++m_refs; }
+        void RemoveReference()
+        {
+            if (!--m_refs)
+                delete this;
+        }
+
+        // queue the callback of a finished query, or drop it if the owner is gone
+        void Deliver(MaNGOS::IQueryCallback* callback);
+        // drop waiting callbacks and release the owner reference
+        void Close();
+
+    private:
+        ~SqlResultQueue() {}
+
+        static void DropCallback(MaNGOS::IQueryCallback* callback);
+
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_refs;
+        ACE_Thread_Mutex m_closeLock;
+        bool m_closed;
 };
 
 class SqlQuery : public SqlOperation
@@ -101,11 +143,14 @@ class SqlQuery : public SqlOperation
         const char* m_sql;
         MaNGOS::IQueryCallback* m_callback;
         SqlResultQueue* m_queue;
+        uint64 m_rows;
     public:
         SqlQuery(const char* sql, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue)
-            : m_sql(mangos_strdup(sql)), m_callback(callback), m_queue(queue) {}
-        ~SqlQuery() { char* tofree = const_cast<char*>(m_sql); delete[] tofree; }
+            : m_sql(mangos_strdup(sql)), m_callback(callback), m_queue(queue), m_rows(0) { if (m_queue) m_queue->AddReference(); }
+        ~SqlQuery();
         bool Execute(SqlConnection* conn) override;
+        void GetProfileKey(Database const& /*db*/, std::string& key) const override { MakeProfileKey(m_sql, key); }
+        uint64 GetProfileRows() const override { return m_rows; }
 };
 
 class SqlQueryHolder
@@ -114,15 +159,41 @@ class SqlQueryHolder
     private:
         typedef std::pair<const char*, QueryResult*> SqlResultPair;
         std::vector<SqlResultPair> m_queries;
+        uint32 m_shardKey;
     public:
-        SqlQueryHolder() {}
+        SqlQueryHolder() : m_shardKey(0) {}
         ~SqlQueryHolder();
         bool SetQuery(size_t index, const char* sql);
         bool SetPQuery(size_t index, const char* format, ...) ATTR_PRINTF(3, 4);
         void SetSize(size_t size);
         QueryResult* GetResult(size_t index);
         void SetResult(size_t index, QueryResult* result);
-        bool Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue);
+        // execute on the async worker used for transactions with the same shard key
+        void SetShardKey(uint32 shardKey) { m_shardKey = shardKey; }
+        bool Execute(MaNGOS::IQueryCallback* callback, Database* db, SqlResultQueue* queue);
+};
+
+/// callback of a delayed holder, the handler owns the holder and a dropped callback deletes it
+template<class Class, typename ParamType1 = void>
+class SqlQueryHolderCallback : public MaNGOS::QueryCallback<Class, SqlQueryHolder*, ParamType1>
+{
+    private:
+        typedef MaNGOS::QueryCallback<Class, SqlQueryHolder*, ParamType1> Base;
+    public:
+        SqlQueryHolderCallback(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*, ParamType1), SqlQueryHolder* holder, ParamType1 param1)
+            : Base(object, method, (QueryResult*)NULL, holder, param1) {}
+        void Drop() override { delete this->m_param2; }
+};
+
+template<class Class>
+class SqlQueryHolderCallback<Class, void> : public MaNGOS::QueryCallback<Class, SqlQueryHolder*>
+{
+    private:
+        typedef MaNGOS::QueryCallback<Class, SqlQueryHolder*> Base;
+    public:
+        SqlQueryHolderCallback(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*), SqlQueryHolder* holder)
+            : Base(object, method, (QueryResult*)NULL, holder) {}
+        void Drop() override { delete this->m_param2; }
 };
 
 class SqlQueryHolderEx : public SqlOperation
@@ -131,9 +202,13 @@ class SqlQueryHolderEx : public SqlOperation
         SqlQueryHolder* m_holder;
         MaNGOS::IQueryCallback* m_callback;
         SqlResultQueue* m_queue;
+        uint64 m_rows;
     public:
         SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue)
-            : m_holder(holder), m_callback(callback), m_queue(queue) {}
+            : m_holder(holder), m_callback(callback), m_queue(queue), m_rows(0) { if (m_queue) m_queue->AddReference(); }
+        ~SqlQueryHolderEx() { if (m_queue) m_queue->RemoveReference(); }
         bool Execute(SqlConnection* conn) override;
+        void GetProfileKey(Database const& db, std::string& key) const override;
+        uint64 GetProfileRows() const override { return m_rows; }
 };
 #endif                                                      //__SQLOPERATIONS_H
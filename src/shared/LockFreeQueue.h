@@ -0,0 +1,157 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LOCKFREEQUEUE_H
+#define LOCKFREEQUEUE_H
+
+#include <ace/Atomic_Op.h>
+#include <ace/Thread_Mutex.h>
+#include "Errors.h"
+
+namespace ACE_Based
+{
+    /**
+     * Bounded multi-producer / single-consumer queue without locks.
+     *
+     * Producers reserve room with an atomic counter and then take the next cell with
+     * an atomic ticket, so add() never waits for other threads and fails when the queue
+     * is full. The consumer walks cells in ticket order, so items come out in the order
+     * their tickets were taken. Only one thread may call next() at a time.
+     */
+    template <class T>
+    class LockFreeQueue
+    {
+            typedef ACE_Atomic_Op<ACE_Thread_Mutex, long> AtomicLong;
+            typedef ACE_Atomic_Op<ACE_Thread_Mutex, unsigned long> AtomicULong;
+
+            struct Cell
+            {
+                T data;
+                AtomicLong ready;                           // 1 after a producer stored data, 0 after consumer took it
+            };
+
+            Cell* _cells;
+            unsigned long _mask;                            // capacity - 1, capacity is a power of 2
+
+            AtomicULong _size;                              // reserved cells, counts items still being added
+            AtomicULong _tail;                              // next producer ticket
+            unsigned long _head;                            // next ticket to consume, consumer only
+
+            AtomicULong _peak;                              // statistics only, updated without ordering
+            AtomicULong _dropped;
+
+            LockFreeQueue(LockFreeQueue const&);
+            LockFreeQueue& operator=(LockFreeQueue const&);
+
+        public:
+
+            //! Create a queue for at least capacity items.
+            explicit LockFreeQueue(unsigned long capacity)
+                : _head(0)
+            {
+                unsigned long size = 1;
+                while (size < capacity)
+                    size <<= 1;
+
+                _cells = new Cell[size];
+                _mask = size - 1;
+
+                _size = 0;
+                _tail = 0;
+                _peak = 0;
+                _dropped = 0;
+            }
+
+            //! Destroy the queue, items left in it are not freed.
+            ~LockFreeQueue()
+            {
+                delete[] _cells;
+            }
+
+            //! Adds an item to the queue, returns false if the queue is full.
+            bool add(const T& item)
+            {
+                unsigned long size = ++_size;
+                if (size > capacity())
+                {
+                    --_size;
+                    ++_dropped;
+                    return false;
+                }
+
+                if (size > _peak.value())
+                    _peak = size;
+
+                // reserved room guarantees that the cell of this ticket was already consumed
+                Cell& cell = _cells[(++_tail - 1) & _mask];
+                cell.data = item;
+                ++cell.ready;                               // full barrier, publish data
+
+                return true;
+            }
+
+            //! Gets the next item in the queue, if any.
+            bool next(T& result)
+            {
+                Cell& cell = _cells[_head & _mask];
+                if (cell.ready.value() == 0)
+                    return false;
+
+                result = cell.data;
+                release(cell);
+                return true;
+            }
+
+            //! Gets the next item in the queue only if checker accepts it, the item stays queued otherwise.
+            template<class Checker>
+            bool next(T& result, Checker& check)
+            {
+                Cell& cell = _cells[_head & _mask];
+                if (cell.ready.value() == 0)
+                    return false;
+
+                result = cell.data;
+                if (!check.Process(result))
+                    return false;
+
+                release(cell);
+                return true;
+            }
+
+            //! Checks if we're empty or not, only exact in the consumer thread.
+            bool empty() const { return _size.value() == 0; }
+
+            //! Current amount of queued items.
+            unsigned long size() const { return _size.value(); }
+            unsigned long capacity() const { return _mask + 1; }
+            //! Most items queued at once.
+            unsigned long peak() const { return _peak.value(); }
+            //! Items rejected by add() because the queue was full.
+            unsigned long dropped() const { return _dropped.value(); }
+
+        private:
+
+            void release(Cell& cell)
+            {
+                --cell.ready;
+                ++_head;
+                --_size;                                    // frees the cell for producers
+            }
+    };
+}
+#endif
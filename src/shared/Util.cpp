@@ -24,6 +24,16 @@
 #include <ace/TSS_T.h>
 #include <ace/INET_Addr.h>
 
+#ifdef WIN32
+#include <windows.h>
+#include <psapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <sys/resource.h>
+#endif
+
 typedef ACE_TSS<MTRand> MTRandTSS;
 static MTRandTSS mtRand;
 
@@ -290,6 +300,27 @@ std::string MoneyToString(uint64 money)
     return ss.str();
 }
 
+uint64 GetPeakMemoryUsage()
+{
+#ifdef WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+
+    return uint64(counters.PeakWorkingSetSize) / 1024;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+#if defined(__APPLE__)
+    return uint64(usage.ru_maxrss) / 1024;                  // bytes on OS X
+#else
+    return uint64(usage.ru_maxrss);
+#endif
+#endif
+}
+
 /// Check if the string is a valid ip address representation
 bool IsIPAddress(char const* ipaddress)
 {
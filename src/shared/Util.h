@@ -41,6 +41,9 @@ time_t timeBitFieldsToSecs(uint32 packedDate);
 
 std::string MoneyToString(uint64 money);
 
+// highest resident memory of the process so far in kB, 0 if the platform can't tell
+uint64 GetPeakMemoryUsage();
+
 inline uint32 secsToTimeBitFields(time_t secs)
 {
     tm* lt = localtime(&secs);